@@ -35,6 +35,27 @@
 #include  "ftp-c_cfg.h"
 
 
+/*
+*********************************************************************************************************
+*                                FTP CLIENT SOCKET OPTIONS STRUCTURES
+*********************************************************************************************************
+*/
+
+const  FTPc_SOCK_OPT  FTPc_CtrlSockOpt = {
+       0u,                                  /* Rx queue size (0 = stack default).                      */
+       0u,                                  /* Tx queue size (0 = stack default).                      */
+    DEF_ENABLED,                            /* Disable Nagle algorithm.                                */
+    DEF_ENABLED                             /* Enable TCP keep-alive.                                  */
+};
+
+const  FTPc_SOCK_OPT  FTPc_DTP_SockOpt = {
+       0u,                                  /* Rx queue size (0 = stack default).                      */
+       0u,                                  /* Tx queue size (0 = stack default).                      */
+    FTPc_SOCK_OPT_DFLT,                     /* Disable Nagle algorithm (stack default).                */
+    FTPc_SOCK_OPT_DFLT                      /* Enable TCP keep-alive   (stack default).                */
+};
+
+
 /*
 *********************************************************************************************************
 *                                 FTP CLIENT CONFIGURATION STRUCTURE
@@ -47,6 +68,7 @@ const  FTPc_CFG  FTPc_Cfg = {
     5000u,                                  /* Maximum inactivity time (ms) on RX.                     */
     5000u,                                  /* Maximum inactivity time (ms) on TX.                     */
      100u,                                  /* Delay between each retries on RX.                       */
+    9216u,                                  /* Maximum length of a reply on RX.                        */
        3u,                                  /* Maximum number of retries on TX.                        */
      100u,                                  /* Delay between each retries on TX.                       */
 
@@ -55,5 +77,9 @@ const  FTPc_CFG  FTPc_Cfg = {
     5000u,                                  /* Maximum inactivity time (ms) on RX.                     */
     5000u,                                  /* Maximum inactivity time (ms) on TX.                     */
        3u,                                  /* Maximum number of retries on TX.                        */
-     100u                                   /* Delay between each retries on TX.                       */
+     100u,                                  /* Delay between each retries on TX.                       */
+
+                                            /* --------------- SOCKET OPTIONS ------------------------ */
+    &FTPc_CtrlSockOpt,                      /* Ctrl socket options.                                    */
+    &FTPc_DTP_SockOpt                       /* DTP  socket options.                                    */
 };
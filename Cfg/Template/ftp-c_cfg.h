@@ -42,6 +42,66 @@
                                                                 /* DEF_DISABLED  Functions using FS DISABLED            */
                                                                 /* DEF_ENABLED   Functions using FS ENABLED             */
 
+                                                                /* Size of ctrl buf embedded in each FTPc_CONN.         */
+#define  FTPc_CFG_CTRL_BUF_SIZE                          1460u
+                                                                /* MUST be >= 128 (see 'ftp-c.h  FTPc SPECIFIC DEFINES  */
+                                                                /* Note #1').                                           */
+
+                                                                /* ENABLED/DISABLE per operation statistics.            */
+#define  FTPc_CFG_STAT_EN                                DEF_DISABLED
+                                                                /* DEF_DISABLED  FTPc_StatGet() DISABLED                */
+                                                                /* DEF_ENABLED   FTPc_StatGet() ENABLED                 */
+
+                                                                /* ENABLED/DISABLE binary trace buffer.                 */
+#define  FTPc_CFG_TRACE_BUF_EN                           DEF_DISABLED
+                                                                /* DEF_DISABLED  FTPc_TraceBuf DISABLED                 */
+                                                                /* DEF_ENABLED   FTPc_TraceBuf ENABLED                  */
+
+                                                                /* Nbr of records in trace buf (MUST be a power of 2).  */
+#define  FTPc_CFG_TRACE_BUF_NBR_EVT                        64u
+
+                                                                /* ENABLED/DISABLE latency & throughput histograms.     */
+#define  FTPc_CFG_HIST_EN                                DEF_DISABLED
+                                                                /* DEF_DISABLED  FTPc_HistGet() DISABLED                */
+                                                                /* DEF_ENABLED   FTPc_HistGet() ENABLED                 */
+
+                                                                /* ENABLED/DISABLE remote file metadata cache.          */
+#define  FTPc_CFG_META_CACHE_EN                          DEF_DISABLED
+                                                                /* DEF_DISABLED  FTPc_FileInfoGet() always queries srv  */
+                                                                /* DEF_ENABLED   FTPc_FileInfoGet() results cached      */
+
+                                                                /* Nbr of cached paths per FTPc_CONN.                   */
+#define  FTPc_CFG_META_CACHE_NBR_ENTRY                      8u
+                                                                /* Max len of cached paths, incl. NULL char.            */
+#define  FTPc_CFG_META_CACHE_PATH_LEN_MAX                  64u
+                                                                /* Time cached metadata remains valid, in ms.           */
+#define  FTPc_CFG_META_CACHE_TTL_MS                      5000u
+
+                                                                /* ENABLED/DISABLE server addr cache of FTPc_Open().    */
+#define  FTPc_CFG_HOST_CACHE_EN                          DEF_DISABLED
+                                                                /* DEF_DISABLED  Host name resolved on each open        */
+                                                                /* DEF_ENABLED   Resolved addr reused until expired     */
+
+                                                                /* Nbr of cached servers.                               */
+#define  FTPc_CFG_HOST_CACHE_NBR_ENTRY                      4u
+                                                                /* Max len of cached host names, incl. NULL char.       */
+#define  FTPc_CFG_HOST_CACHE_NAME_LEN_MAX                  64u
+                                                                /* Time resolved addr remains valid, in ms.             */
+#define  FTPc_CFG_HOST_CACHE_TTL_MS                    300000u
+
+                                                                /* ENABLED/DISABLE data xfer rate limit.                */
+#define  FTPc_CFG_RATE_LIMIT_EN                          DEF_DISABLED
+                                                                /* DEF_DISABLED  FTPc_RateLimitSet() DISABLED           */
+                                                                /* DEF_ENABLED   FTPc_RateLimitSet() ENABLED            */
+
+                                                                /* ENABLED/DISABLE data xfer priority classes.          */
+#define  FTPc_CFG_SCHED_EN                               DEF_DISABLED
+                                                                /* DEF_DISABLED  FTPc_PrioSet() DISABLED                */
+                                                                /* DEF_ENABLED   FTPc_PrioSet() ENABLED                 */
+
+                                                                /* Max pause per class of difference, in ms.            */
+#define  FTPc_CFG_SCHED_PAUSE_MAX_MS                      500u
+
 
 /*
 *********************************************************************************************************
@@ -61,7 +121,7 @@
 #define  TRACE_LEVEL_DBG                                   2
 #endif
 
-#define  FTPc_TRACE_LEVEL                       TRACE_LEVEL_INFO
+#define  FTPc_TRACE_LEVEL                       TRACE_LEVEL_OFF
 #define  FTPc_TRACE                             printf
 
 #endif
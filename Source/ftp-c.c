@@ -43,6 +43,7 @@
 #include  <Source/net_conn.h>
 #include  <Source/net_app.h>
 #include  <Source/net_sock.h>
+#include  <Source/net_util.h>
 
 
 /*
@@ -51,6 +52,16 @@
 *********************************************************************************************************
 */
 
+#define  FTPc_TX_DLY_MIN_MS                                1u   /* Min dly between tx retries (see FTPc_Tx() Note #2).  */
+#define  FTPc_DTP_RX_POLL_MS                              20u   /* Data rx poll period (see FTPc_DTP_Rx() Note #2).     */
+#define  FTPc_DTP_RX_REPLY_POLL_NBR                        5u   /* Data polls after reply (see FTPc_DTP_Rx() Note #1b). */
+#define  FTPc_BLK_DEV_PAD_VAL                           0xFFu   /* Pad of last blk (see FTPc_RecvBlkDev() Note #4).     */
+#define  FTPc_TYPE_UNKNOWN                               '\0'   /* Data type not yet set on server.                     */
+#define  FTPc_REMOTE_OP_WIN_SIZE                           8u   /* Max nbr of pipelined remote op cmds.                 */
+#define  FTPc_PROT_UNKNOWN                               '\0'   /* Protection level not yet set on server.              */
+#define  FTPc_SCHED_PAUSE_POLL_MS                         20u   /* Pause poll period (see FTPc_SchedYield() Note #1).   */
+#define  FTPc_XFER_ABORT_REPLY_MAX                         4u   /* Max nbr of replies rx'd after ABOR.                  */
+
 
 /*
 *********************************************************************************************************
@@ -75,7 +86,7 @@
 #endif
 
 #ifndef FTPc_CFG_DFLT_CTRL_MAX_RX_REPLY_LEN
-    #define  FTPc_CFG_DFLT_CTRL_MAX_RX_REPLY_LEN       9196u    /* Max server reply size if lengthy welcome msg is rx'd.*/
+    #define  FTPc_CFG_DFLT_CTRL_MAX_RX_REPLY_LEN       9216u    /* Max server reply size if lengthy welcome msg is rx'd.*/
 #endif
 
 #ifndef FTPc_CFG_DFLT_CTRL_MAX_TX_RETRY
@@ -107,48 +118,6 @@
 #endif
 
 
-/*
-*********************************************************************************************************
-*                                            FTP COMMANDS
-*********************************************************************************************************
-*/
-
-#define  FTP_CMD_NOOP                                      0
-#define  FTP_CMD_QUIT                                      1
-#define  FTP_CMD_REIN                                      2
-#define  FTP_CMD_SYST                                      3
-#define  FTP_CMD_FEAT                                      4
-#define  FTP_CMD_HELP                                      5
-#define  FTP_CMD_USER                                      6
-#define  FTP_CMD_PASS                                      7
-#define  FTP_CMD_MODE                                      8
-#define  FTP_CMD_TYPE                                      9
-#define  FTP_CMD_STRU                                     10
-#define  FTP_CMD_PASV                                     11
-#define  FTP_CMD_PORT                                     12
-#define  FTP_CMD_PWD                                      13
-#define  FTP_CMD_CWD                                      14
-#define  FTP_CMD_CDUP                                     15
-#define  FTP_CMD_MKD                                      16
-#define  FTP_CMD_RMD                                      17
-#define  FTP_CMD_NLST                                     18
-#define  FTP_CMD_LIST                                     19
-#define  FTP_CMD_RETR                                     20
-#define  FTP_CMD_STOR                                     21
-#define  FTP_CMD_APPE                                     22
-#define  FTP_CMD_REST                                     23
-#define  FTP_CMD_DELE                                     24
-#define  FTP_CMD_RNFR                                     25
-#define  FTP_CMD_RNTO                                     26
-#define  FTP_CMD_SIZE                                     27
-#define  FTP_CMD_MDTM                                     28
-#define  FTP_CMD_PBSZ                                     29
-#define  FTP_CMD_PROT                                     30
-#define  FTP_CMD_EPSV                                     31
-#define  FTP_CMD_EPRT                                     32
-#define  FTP_CMD_MAX                                      33    /* This line MUST be the LAST!                          */
-
-
 /*
 *********************************************************************************************************
 *                                         FTP REPLY MESSAGES
@@ -202,22 +171,90 @@
 #define  FTP_ASCII_SPACE                                 ' '    /* Space.                                               */
 
 #define  FTP_ASCII_EPSV_PREFIX                           "|||"
-#define  FTP_MULTI_REPLY_DELIM                           "/"    /* Indicates multiple FTP server replies in resp. buf.  */
 
 #define  FTP_EOL_DELIMITER_LEN                            2     /* EOL delimiter is CRLF.                               */
 
 
 /*
 *********************************************************************************************************
-*                                            FTP DATA TYPE
+*                                            LOCAL MACRO'S
+*
+* Note(s) : (1) Statistics macros expand to nothing when FTPc_CFG_STAT_EN is DEF_DISABLED, trace
+*               buffer macros expand to nothing when FTPc_CFG_TRACE_BUF_EN is DEF_DISABLED, histogram
+*               macros expand to nothing when FTPc_CFG_HIST_EN is DEF_DISABLED, metadata cache macros
+*               expand to nothing when FTPc_CFG_META_CACHE_EN is DEF_DISABLED, throttling macros expand
+*               to nothing when FTPc_CFG_RATE_LIMIT_EN is DEF_DISABLED & scheduling macros expand to
+*               nothing when FTPc_CFG_SCHED_EN is DEF_DISABLED.
 *********************************************************************************************************
 */
 
-                                                                /* Data type "IMAGE" supported only.                    */
-#define  FTP_TYPE_ASCII                                  'A'
-#define  FTP_TYPE_EBCDIC                                 'E'
-#define  FTP_TYPE_IMAGE                                  'I'
-#define  FTP_TYPE_LOCAL                                  'L'
+#if (FTPc_CFG_STAT_EN == DEF_ENABLED)                           /* See Note #1.                                         */
+#define  FTPc_STAT_RESET(p_conn)                    { Mem_Clr(&(p_conn)->Stat, sizeof((p_conn)->Stat)); }
+#define  FTPc_STAT_TS(p_conn, ts)                   { (p_conn)->Stat.ts = FTPc_TS_GET(); }
+#define  FTPc_STAT_TS_FIRST(p_conn, ts)             { if ((p_conn)->Stat.ts == 0u) { (p_conn)->Stat.ts = FTPc_TS_GET(); } }
+#define  FTPc_STAT_INC(p_conn, ctr)                 { (p_conn)->Stat.ctr++; }
+#define  FTPc_STAT_ADD(p_conn, ctr, val)            { (p_conn)->Stat.ctr += (val); }
+#else
+#define  FTPc_STAT_RESET(p_conn)
+#define  FTPc_STAT_TS(p_conn, ts)
+#define  FTPc_STAT_TS_FIRST(p_conn, ts)
+#define  FTPc_STAT_INC(p_conn, ctr)
+#define  FTPc_STAT_ADD(p_conn, ctr, val)
+#endif
+
+#if (FTPc_CFG_TRACE_BUF_EN == DEF_ENABLED)                      /* See 'ftp-c.h  FTPc TRACE BUFFER'.                    */
+#define  FTPc_TRACE_EVT(evt_id, arg0, arg1)         { FTPc_TraceWr((evt_id), (CPU_INT32U)(arg0), (CPU_INT32U)(arg1)); }
+#else
+#define  FTPc_TRACE_EVT(evt_id, arg0, arg1)
+#endif
+
+#if (FTPc_CFG_HIST_EN == DEF_ENABLED)
+#define  FTPc_HIST_CMD_START(p_conn, p_cmd, len)    { FTPc_HistCmdStart((p_conn), (p_cmd), (len)); }
+#define  FTPc_HIST_CMD_END(p_conn)                  { FTPc_HistCmdEnd((p_conn)); }
+#define  FTPc_HIST_CMD_CLR(p_conn)                  { (p_conn)->HistCmdCode = FTP_CMD_MAX; }
+#define  FTPc_HIST_CONN_START(p_conn)               { (p_conn)->HistTS = FTPc_TS_GET(); }
+#define  FTPc_HIST_CONN_END(p_conn)                 { FTPc_HistUpdate(FTPc_Hist.ConnLat, FTPc_TS_TO_uS(FTPc_TS_GET() - (p_conn)->HistTS)); }
+#define  FTPc_HIST_XFER_START(p_conn)               { (p_conn)->HistXferTS = FTPc_TS_GET(); (p_conn)->HistXferLen = 0u; }
+#define  FTPc_HIST_XFER_ADD(p_conn, len)            { (p_conn)->HistXferLen += (len); }
+#define  FTPc_HIST_XFER_END(p_conn)                 { FTPc_HistXferEnd((p_conn)); }
+#else
+#define  FTPc_HIST_CMD_START(p_conn, p_cmd, len)
+#define  FTPc_HIST_CMD_END(p_conn)
+#define  FTPc_HIST_CMD_CLR(p_conn)
+#define  FTPc_HIST_CONN_START(p_conn)
+#define  FTPc_HIST_CONN_END(p_conn)
+#define  FTPc_HIST_XFER_START(p_conn)
+#define  FTPc_HIST_XFER_ADD(p_conn, len)
+#define  FTPc_HIST_XFER_END(p_conn)
+#endif
+
+#if (FTPc_CFG_META_CACHE_EN == DEF_ENABLED)                     /* See 'ftp-c.h  FTPc METADATA CACHE'.                  */
+#define  FTPc_META_CACHE_INV(p_conn, p_path)        { FTPc_MetaCacheInv((p_conn), (p_path)); }
+#else
+#define  FTPc_META_CACHE_INV(p_conn, p_path)
+#endif
+
+#if (FTPc_CFG_RATE_LIMIT_EN == DEF_ENABLED)                     /* See 'ftp-c.h  FTPc RATE LIMIT'.                      */
+#define  FTPc_DTP_THROTTLE(p_conn, len)             { FTPc_DTP_Throttle((p_conn), (len)); }
+#else
+#define  FTPc_DTP_THROTTLE(p_conn, len)
+#endif
+
+#if (FTPc_CFG_SCHED_EN == DEF_ENABLED)                          /* See 'ftp-c.h  FTPc TRANSFER PRIORITY'.               */
+#define  FTPc_SCHED_XFER_START(p_conn)              { FTPc_SchedXferSet((p_conn), DEF_YES); }
+#define  FTPc_SCHED_XFER_END(p_conn)                { FTPc_SchedXferSet((p_conn), DEF_NO);  }
+#define  FTPc_SCHED_YIELD(p_conn)                   { FTPc_SchedYield(p_conn); }
+#else
+#define  FTPc_SCHED_XFER_START(p_conn)
+#define  FTPc_SCHED_XFER_END(p_conn)
+#define  FTPc_SCHED_YIELD(p_conn)
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__))                   /* See FTPc_AsciiFind() Note #2.                        */
+#define  FTPc_WORD_RD(p_word, p_src)                { *(p_word) = *(const FTPc_WORD_ALIAS *)(p_src); }
+#else
+#define  FTPc_WORD_RD(p_word, p_src)                { Mem_Copy((p_word), (p_src), sizeof(CPU_INT32U)); }
+#endif
 
 
 /*
@@ -233,6 +270,19 @@ typedef struct  FTPc_CmdStruct {
     const  CPU_CHAR    *CmdStr;
 }  FTPc_CMD_STRUCT;
 
+#if (defined(__GNUC__) || defined(__clang__))                   /* Word that MAY alias any obj (see FTPc_WORD_RD()).    */
+typedef  CPU_INT32U  __attribute__((__may_alias__))  FTPc_WORD_ALIAS;
+#endif
+
+#if (FTPc_CFG_HOST_CACHE_EN == DEF_ENABLED)
+typedef  struct  ftpc_host_entry {                              /* Last good addr of a server (see FTPc_HostOpen()).    */
+    CPU_CHAR            Name[FTPc_CFG_HOST_CACHE_NAME_LEN_MAX]; /* Host name; empty if entry is free.                   */
+    NET_IP_ADDR_FAMILY  Family;
+    CPU_INT08U          Addr[NET_IP_MAX_ADDR_SIZE];             /* Addr, in the format of FTPc_Conn().                  */
+    CPU_INT32U          TS_ms;                                  /* Time the addr was resolved.                          */
+} FTPc_HOST_ENTRY;
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -240,6 +290,22 @@ typedef struct  FTPc_CmdStruct {
 *********************************************************************************************************
 */
 
+#if (FTPc_CFG_HIST_EN == DEF_ENABLED)
+static  FTPc_HIST  FTPc_Hist;                                   /* See 'ftp-c.h  FTPc HISTOGRAMS DATA TYPE'.            */
+#endif
+
+#if (FTPc_CFG_HOST_CACHE_EN == DEF_ENABLED)
+static  FTPc_HOST_ENTRY  FTPc_HostCache[FTPc_CFG_HOST_CACHE_NBR_ENTRY];
+#endif
+
+#if (FTPc_CFG_SCHED_EN == DEF_ENABLED)
+static  CPU_INT16U       FTPc_SchedXferCtr[FTPc_PRIO_NBR];      /* Nbr of active xfers per prio class.                  */
+#endif
+
+#if (FTPc_CFG_RATE_LIMIT_EN == DEF_ENABLED)
+static  FTPc_RATE_LIMIT  FTPc_RateLimitGlobal;                  /* Bucket shared by all conns (see FTPc_RateLimitSet()).*/
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -247,8 +313,6 @@ typedef struct  FTPc_CmdStruct {
 *********************************************************************************************************
 */
 
-static  const  FTPc_CFG  *FTPc_CfgPtr;
-
 static  const  FTPc_CFG   FTPc_DfltCfg = {
 
     FTPc_CFG_DFLT_CTRL_MAX_CONN_TIMEOUT_MS,
@@ -266,7 +330,10 @@ static  const  FTPc_CFG   FTPc_DfltCfg = {
     FTPc_CFG_DFLT_DTP_MAX_TX_TIMEOUT_MS,
 
     FTPc_CFG_DFLT_DTP_MAX_TX_RETRY,
-    FTPc_CFG_DFLT_DTP_MAX_TX_DLY_MS
+    FTPc_CFG_DFLT_DTP_MAX_TX_DLY_MS,
+
+    DEF_NULL,
+    DEF_NULL
 };
 
 
@@ -313,6 +380,7 @@ static  const  FTPc_CMD_STRUCT  FTPc_Cmd[] = {
     { FTP_CMD_PROT,  (const  CPU_CHAR *)"PROT" },
     { FTP_CMD_PASV,  (const  CPU_CHAR *)"EPSV" },
     { FTP_CMD_EPRT,  (const  CPU_CHAR *)"EPRT" },
+    { FTP_CMD_ABOR,  (const  CPU_CHAR *)"ABOR" },
     { FTP_CMD_MAX,   (const  CPU_CHAR *)"MAX"  }                /* This line MUST be the LAST!                          */
 };
 
@@ -323,28 +391,202 @@ static  const  FTPc_CMD_STRUCT  FTPc_Cmd[] = {
 *********************************************************************************************************
 */
 
-static  CPU_INT32U  FTPc_WaitForStatus(FTPc_CONN   *p_conn,
-                                       CPU_CHAR    *p_ctrl_data,
-                                       CPU_INT16U   ctrl_data_len,
-                                       NET_ERR     *p_err);
+static  CPU_INT32U   FTPc_WaitForStatus  (FTPc_CONN   *p_conn,
+                                          CPU_CHAR    *p_ctrl_data,
+                                          CPU_INT16U   ctrl_data_len,
+                                          NET_ERR     *p_err);
+
+static  CPU_BOOLEAN  FTPc_ReplyLineParse (CPU_CHAR    *p_line,
+                                          CPU_INT16U   line_len,
+                                          CPU_INT16U  *p_multi_code,
+                                          CPU_INT16U  *p_code);
+
+static  void         FTPc_ReplyLineCopy  (CPU_CHAR    *p_line,
+                                          CPU_INT16U   line_len,
+                                          CPU_CHAR    *p_dest,
+                                          CPU_INT16U   dest_len);
+
+static  CPU_INT32S   FTPc_RxReply        (FTPc_CONN   *p_conn,
+                                          CPU_CHAR    *p_data,
+                                          CPU_INT16U   data_len,
+                                          NET_ERR     *p_err);
+
+static  CPU_BOOLEAN  FTPc_Tx             (FTPc_CONN   *p_conn,
+                                          CPU_INT32S   sock_id,
+                                          CPU_CHAR    *p_data,
+                                          CPU_INT16U   data_len,
+                                          CPU_INT32U   timeout_ms,
+                                          CPU_INT16U   retry_max,
+                                          CPU_INT32U   time_dly_ms,
+                                          NET_ERR     *p_err);
+
+static  NET_SOCK_ID  FTPc_Conn           (FTPc_CONN   *p_conn,
+                                          CPU_CHAR    *p_ctrl_buf,
+                                          CPU_INT16U   ctrl_buf_size,
+                                          FTPc_ERR    *p_err);
+
+static  CPU_BOOLEAN  FTPc_PasvReq        (FTPc_CONN   *p_conn,
+                                          CPU_CHAR    *p_ctrl_buf,
+                                          CPU_INT16U   ctrl_buf_size,
+                                          FTPc_ERR    *p_err);
+
+static  CPU_BOOLEAN  FTPc_PasvReply      (FTPc_CONN   *p_conn,
+                                          CPU_CHAR    *p_ctrl_buf,
+                                          CPU_INT16U   ctrl_buf_size,
+                                          FTPc_ERR    *p_err);
+
+static  CPU_BOOLEAN  FTPc_CmdTx          (FTPc_CONN   *p_conn,
+                                          CPU_INT08U   cmd,
+                                          CPU_CHAR    *p_arg,
+                                          CPU_CHAR    *p_ctrl_buf,
+                                          CPU_INT16U   ctrl_buf_size,
+                                          FTPc_ERR    *p_err);
+
+static  void         FTPc_RemoteOpAbort  (FTPc_REMOTE_OP  *p_op_tbl,
+                                          CPU_SIZE_T       op_ix_rx,
+                                          CPU_SIZE_T       op_ix_tx,
+                                          CPU_SIZE_T       op_nbr);
+
+#if (FTPc_CFG_META_CACHE_EN == DEF_ENABLED)
+static  FTPc_META_ENTRY  *FTPc_MetaCacheGet (       FTPc_CONN       *p_conn,
+                                             const  CPU_CHAR        *p_path);
+
+static  void              FTPc_MetaCachePut (       FTPc_CONN       *p_conn,
+                                             const  CPU_CHAR        *p_path,
+                                             const  FTPc_FILE_INFO  *p_info);
+
+static  void              FTPc_MetaCacheInv (       FTPc_CONN       *p_conn,
+                                             const  CPU_CHAR        *p_path);
+#endif
+
+static  NET_IP_ADDR_FAMILY  FTPc_HostOpen (FTPc_CONN                *p_conn,
+                                           CPU_CHAR                 *p_host,
+                                           NET_PORT_NBR              port_nbr,
+                                           NET_APP_SOCK_SECURE_CFG  *p_secure,
+                                           NET_ERR                  *p_err);
+
+#if (FTPc_CFG_HOST_CACHE_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  FTPc_HostCacheGet   (const  CPU_CHAR         *p_host,
+                                                 FTPc_HOST_ENTRY  *p_entry);
+
+static  void         FTPc_HostCachePut   (const  CPU_CHAR         *p_host,
+                                                 FTPc_CONN        *p_conn);
+#endif
+
+#ifdef  NET_SECURE_MODULE_EN
+static  NET_SOCK_ID  FTPc_ConnSecureResume(FTPc_CONN   *p_conn,
+                                           CPU_INT08U  *p_addr,
+                                           NET_ERR     *p_err);
+
+static  void         FTPc_SecureSessionFree(FTPc_CONN  *p_conn);
+
+static  CPU_BOOLEAN  FTPc_ProtReq        (FTPc_CONN   *p_conn,
+                                          CPU_CHAR     prot,
+                                          CPU_CHAR    *p_ctrl_buf,
+                                          CPU_INT16U   ctrl_buf_size,
+                                          FTPc_ERR    *p_err);
+#endif
+
+#if (FTPc_CFG_RATE_LIMIT_EN == DEF_ENABLED)
+static  void         FTPc_DTP_Throttle   (FTPc_CONN        *p_conn,
+                                          CPU_INT32U        len);
+
+static  CPU_INT32U   FTPc_RateLimitTake  (FTPc_RATE_LIMIT  *p_bucket,
+                                          CPU_INT32U        len,
+                                          CPU_INT32U        ts_ms);
+#endif
+
+#if (FTPc_CFG_SCHED_EN == DEF_ENABLED)
+static  void         FTPc_SchedXferSet   (FTPc_CONN    *p_conn,
+                                          CPU_BOOLEAN   en);
+
+static  void         FTPc_SchedYield     (FTPc_CONN    *p_conn);
+#endif
+
+static  CPU_BOOLEAN  FTPc_TypeReq        (FTPc_CONN   *p_conn,
+                                          CPU_CHAR     type,
+                                          CPU_CHAR    *p_ctrl_buf,
+                                          CPU_INT16U   ctrl_buf_size,
+                                          FTPc_ERR    *p_err);
+
+static  CPU_BOOLEAN  FTPc_XferEnd        (FTPc_CONN   *p_conn,
+                                          NET_SOCK_ID  sock_dtp_id,
+                                          CPU_BOOLEAN  xfer_open,
+                                          CPU_CHAR    *p_ctrl_buf,
+                                          CPU_INT16U   ctrl_buf_size,
+                                          FTPc_ERR    *p_err);
+
+static  void         FTPc_SockOptApply   (      NET_SOCK_ID     sock_id,
+                                          const FTPc_SOCK_OPT  *p_opt);
+
+static  CPU_INT32S   FTPc_DTP_Rx         (FTPc_CONN   *p_conn,
+                                          NET_SOCK_ID  sock_dtp_id,
+                                          CPU_CHAR    *p_buf,
+                                          CPU_INT16U   buf_len,
+                                          FTPc_ERR    *p_err);
+
+static  CPU_BOOLEAN  FTPc_CtrlReplyRdy   (FTPc_CONN   *p_conn);
+
+#if (FTPc_CFG_USE_FS == DEF_ENABLED)
+static  void        *FTPc_FileSrcOpenFS  (CPU_CHAR    *p_name);
+#endif
+
+static  CPU_BOOLEAN  FTPc_BlkDevWr       (FTPc_BLK_DEV  *p_dev,
+                                          CPU_INT32U     addr,
+                                          FTPc_ERR      *p_err);
+
+static  CPU_SIZE_T   FTPc_AsciiFind      (const  CPU_CHAR    *p_buf,
+                                                 CPU_SIZE_T   buf_len,
+                                                 CPU_CHAR     c);
+
+static  CPU_SIZE_T   FTPc_AsciiRxConv    (FTPc_CONN   *p_conn,
+                                          CPU_CHAR    *p_buf,
+                                          CPU_SIZE_T   buf_len);
+
+static  CPU_SIZE_T   FTPc_AsciiTxConv    (       FTPc_CONN   *p_conn,
+                                          const  CPU_CHAR    *p_src,
+                                                 CPU_SIZE_T   src_len,
+                                                 CPU_CHAR    *p_dest,
+                                                 CPU_SIZE_T   dest_len,
+                                                 CPU_SIZE_T  *p_src_used);
+
+#if (FTPc_CFG_TRACE_BUF_EN == DEF_ENABLED)
+static  void         FTPc_TraceWr        (CPU_INT16U   evt_id,
+                                          CPU_INT32U   arg0,
+                                          CPU_INT32U   arg1);
+#endif
+
+#if (FTPc_CFG_HIST_EN == DEF_ENABLED)
+static  void         FTPc_HistCmdStart   (FTPc_CONN   *p_conn,
+                                          CPU_CHAR    *p_cmd,
+                                          CPU_INT16U   cmd_len);
+
+static  void         FTPc_HistCmdEnd     (FTPc_CONN   *p_conn);
+
+static  void         FTPc_HistXferEnd    (FTPc_CONN   *p_conn);
+
+static  void         FTPc_HistUpdate     (CPU_INT32U  *p_bkt_tbl,
+                                          CPU_INT32U   val);
+#endif
 
-static  CPU_INT32S  FTPc_RxReply      (CPU_INT32S   sock_id,
-                                       CPU_CHAR    *p_data,
-                                       CPU_INT16U   data_len,
-                                       NET_ERR     *p_err);
 
-static  CPU_BOOLEAN  FTPc_Tx          (CPU_INT32S   sock_id,
-                                       CPU_CHAR    *p_data,
-                                       CPU_INT16U   data_len,
-                                       CPU_INT32U   timeout_ms,
-                                       CPU_INT16U   retry_max,
-                                       CPU_INT32U   time_dly_ms,
-                                       NET_ERR     *p_err);
+/*
+*********************************************************************************************************
+*                                       FILE SYSTEM FILE SOURCE
+*
+* Note(s) : (1) File source used by FTPc_SendFile() to read files through the network file system
+*               abstraction. Files are never mapped in memory.
+*********************************************************************************************************
+*/
 
-static  NET_SOCK_ID  FTPc_Conn        (FTPc_CONN   *p_conn,
-                                       CPU_CHAR    *p_ctrl_buf,
-                                       CPU_INT16U   ctrl_buf_size,
-                                       FTPc_ERR    *p_err);
+#if (FTPc_CFG_USE_FS == DEF_ENABLED)
+static  const  FTPc_FILE_SRC_API  FTPc_FileSrcFS = {            /* See Note #1.                                         */
+    FTPc_FileSrcOpenFS,
+    DEF_NULL,
+    NetFS_FileRd,
+    NetFS_FileClose
+};
+#endif
 
 
 /*
@@ -373,6 +615,7 @@ static  NET_SOCK_ID  FTPc_Conn        (FTPc_CONN   *p_conn,
 *
 *                                   TFTPc_ERR_NONE              Open Connection to server succeeded.
 *                                   FTPc_ERR_CONN_FAIL          Open Connection failed.
+*                                   FTPc_ERR_CMD_LEN            Command longer than control buffer.
 *                                   FTPc_ERR_TX_CMD             Sending Command failed.
 *                                   FTPc_ERR_RX_CMD_RESP_FAIL   Receiving Command response failed.
 *                                   FTPc_ERR_LOGGEDIN           Log in failed.
@@ -386,6 +629,12 @@ static  NET_SOCK_ID  FTPc_Conn        (FTPc_CONN   *p_conn,
 *                    connection.
 *
 *                (2) If the secure mode is enabled, the client MUST send a PBSZ & PROT commands.
+*
+*                (3) When FTPc_CFG_HOST_CACHE_EN is DEF_ENABLED, the server host name is only resolved
+*                    when its cached address is older than FTPc_CFG_HOST_CACHE_TTL_MS (see FTPc_HostOpen()).
+*
+*                (4) The TLS session of the control connection is resumed by the data connections (see
+*                    'ftp-c.h  FTP SECURE CFG DATA TYPE  Note #2').
 *********************************************************************************************************
 */
 
@@ -400,34 +649,60 @@ CPU_BOOLEAN  FTPc_Open (      FTPc_CONN        *p_conn,
 {
     CPU_CHAR     ctrl_buf[FTPc_CTRL_NET_BUF_SIZE];
     CPU_INT32U   ctrl_buf_size;
-    CPU_INT32U   buf_size;
     CPU_INT32U   reply_code;
     CPU_BOOLEAN  rtn_code;
     NET_ERR      err;
 
 
     if (p_cfg == DEF_NULL) {
-        p_cfg       = &FTPc_DfltCfg;
-        FTPc_CfgPtr =  p_cfg;
-    } else {
-        FTPc_CfgPtr =  p_cfg;
+        p_cfg = &FTPc_DfltCfg;
     }
+    p_conn->CfgPtr = p_cfg;
 
 #ifdef  NET_SECURE_MODULE_EN
-    p_conn->SecureCfgPtr = p_secure_cfg;
+    p_conn->SecureCfgPtr     = p_secure_cfg;
+    p_conn->SecureSessionPtr = DEF_NULL;
+    p_conn->Prot             = FTP_PROT_PRIVATE;
+    p_conn->ProtCur          = FTPc_PROT_UNKNOWN;
 #endif
 
-    ctrl_buf_size = sizeof(ctrl_buf);
+    ctrl_buf_size    = sizeof(ctrl_buf);
+    p_conn->BufLen   = 0u;
+    p_conn->BatchEn  = DEF_DISABLED;
+    p_conn->PasvRdy  = DEF_NO;
+    p_conn->CtrlFail = DEF_NO;
+    p_conn->Type     = FTP_TYPE_IMAGE;
+    p_conn->TypeCur  = FTPc_TYPE_UNKNOWN;
+    FTPc_META_CACHE_INV(p_conn, DEF_NULL);
+#if (FTPc_CFG_RATE_LIMIT_EN == DEF_ENABLED)
+    Mem_Clr(&p_conn->RateLimit, sizeof(p_conn->RateLimit));     /* No limit by default.                                 */
+#endif
+#if (FTPc_CFG_SCHED_EN == DEF_ENABLED)
+    p_conn->Prio        = FTPc_PRIO_NORMAL;
+    p_conn->SchedXferEn = DEF_NO;
+#endif
 
-    p_conn->SockAddrFamily = NetApp_ClientStreamOpenByHostname(&p_conn->SockID,
-                                                                p_host_server,
-                                                                port_nbr,
-                                                               &p_conn->SockAddr,
-                                     (NET_APP_SOCK_SECURE_CFG *)p_secure_cfg,
-                                                                p_cfg->CtrlConnMaxTimout_ms,
-                                                               &err);
+    FTPc_STAT_RESET(p_conn);
+    FTPc_STAT_TS(p_conn, TS_Start);
+    FTPc_HIST_CMD_CLR(p_conn);
+    FTPc_HIST_CONN_START(p_conn);
+
+    p_conn->SockAddrFamily = FTPc_HostOpen(p_conn,              /* See Note #3.                                         */
+                                           p_host_server,
+                                           port_nbr,
+                         (NET_APP_SOCK_SECURE_CFG *)p_secure_cfg,
+                                          &err);
     switch (err) {
         case NET_APP_ERR_NONE:
+             FTPc_STAT_TS(p_conn, TS_Conn);
+             FTPc_HIST_CONN_END(p_conn);
+#ifdef  NET_SECURE_MODULE_EN
+                                                                /* Keep ctrl conn TLS session (see Note #4).            */
+             if ((p_secure_cfg                != DEF_NULL) &&
+                 (p_secure_cfg->SessionApiPtr != DEF_NULL)) {
+                 p_conn->SecureSessionPtr = p_secure_cfg->SessionApiPtr->Get(p_conn->SockID);
+             }
+#endif
              break;
 
         default:
@@ -443,6 +718,8 @@ CPU_BOOLEAN  FTPc_Open (      FTPc_CONN        *p_conn,
        *p_err = FTPc_ERR_CONN_FAIL;
         goto exit_close_sock;
     }
+                                                                /* ---------------- CFG SOCK TUNING OPT --------------- */
+    FTPc_SockOptApply(p_conn->SockID, p_cfg->CtrlSockOptPtr);
 
                                                                 /* Receive status lines until "server ready status".    */
     while (DEF_OK) {
@@ -461,17 +738,8 @@ CPU_BOOLEAN  FTPc_Open (      FTPc_CONN        *p_conn,
 
                                                                 /* ******** USERNAME ************************************/
                                                                 /* Send USER command.                                   */
-    buf_size = Str_FmtPrint((char *)ctrl_buf, ctrl_buf_size, "%s %s\r\n", FTPc_Cmd[FTP_CMD_USER].CmdStr, p_user);
-    rtn_code = FTPc_Tx(p_conn->SockID,
-                       ctrl_buf,
-                       buf_size,
-                       p_cfg->CtrlTxMaxTimout_ms,
-                       p_cfg->CtrlTxMaxRetry,
-                       p_cfg->CtrlTxMaxDly_ms,
-                      &err);
-    FTPc_TRACE_INFO(("FTPc TX: %s", ctrl_buf));
+    rtn_code = FTPc_CmdTx(p_conn, FTP_CMD_USER, p_user, ctrl_buf, ctrl_buf_size, p_err);
     if (rtn_code == DEF_FAIL) {
-       *p_err    = FTPc_ERR_TX_CMD;
         goto exit_close_sock;
     }
 
@@ -484,18 +752,8 @@ CPU_BOOLEAN  FTPc_Open (      FTPc_CONN        *p_conn,
 
                                                                 /* ******** PASSWORD ************************************/
                                                                 /* Send PASS command.                                   */
-    buf_size = Str_FmtPrint((char *)ctrl_buf, ctrl_buf_size, "%s %s\r\n", FTPc_Cmd[FTP_CMD_PASS].CmdStr, p_pass);
-    rtn_code = FTPc_Tx(p_conn->SockID,
-                       ctrl_buf,
-                       buf_size,
-                       p_cfg->CtrlTxMaxTimout_ms,
-                       p_cfg->CtrlTxMaxRetry,
-                       p_cfg->CtrlTxMaxDly_ms,
-                      &err);
-
-    FTPc_TRACE_INFO(("FTPc TX: PASS ******"));
+    rtn_code = FTPc_CmdTx(p_conn, FTP_CMD_PASS, p_pass, ctrl_buf, ctrl_buf_size, p_err);
     if (rtn_code == DEF_FAIL) {
-        *p_err = FTPc_ERR_TX_CMD;
          goto exit_close_sock;
     }
 
@@ -505,21 +763,13 @@ CPU_BOOLEAN  FTPc_Open (      FTPc_CONN        *p_conn,
         *p_err = FTPc_ERR_LOGGEDIN;
          goto exit_close_sock;
     }
+    FTPc_STAT_TS(p_conn, TS_Login);
 
 #ifdef  NET_SECURE_MODULE_EN
     if (p_conn->SecureCfgPtr != DEF_NULL) {                    /* See Note #2.                                          */
                                                                /* Send PBSZ command.                                    */
-        buf_size = Str_FmtPrint((char *)ctrl_buf, ctrl_buf_size, "%s %s\r\n", FTPc_Cmd[FTP_CMD_PBSZ].CmdStr, (CPU_CHAR *)"0");
-        rtn_code = FTPc_Tx(p_conn->SockID,
-                           ctrl_buf,
-                           buf_size,
-                           p_cfg->CtrlTxMaxTimout_ms,
-                           p_cfg->CtrlTxMaxRetry,
-                           p_cfg->CtrlTxMaxDly_ms,
-                           &err);
-        FTPc_TRACE_INFO(("FTPc TX: %s", ctrl_buf));
+        rtn_code = FTPc_CmdTx(p_conn, FTP_CMD_PBSZ, (CPU_CHAR *)"0", ctrl_buf, ctrl_buf_size, p_err);
         if (rtn_code == DEF_FAIL) {
-            *p_err = FTPc_ERR_TX_CMD;
              goto exit_close_sock;
         }
 
@@ -530,29 +780,14 @@ CPU_BOOLEAN  FTPc_Open (      FTPc_CONN        *p_conn,
              goto exit_close_sock;
         }
                                                                 /* Send PROT command.                                   */
-        buf_size = Str_FmtPrint((char *)ctrl_buf, ctrl_buf_size, "%s %s\r\n", FTPc_Cmd[FTP_CMD_PROT].CmdStr, "P");
-        rtn_code = FTPc_Tx(p_conn->SockID,
-                           ctrl_buf,
-                           buf_size,
-                           p_cfg->CtrlTxMaxTimout_ms,
-                           p_cfg->CtrlTxMaxRetry,
-                           p_cfg->CtrlTxMaxDly_ms,
-                          &err);
-        FTPc_TRACE_INFO(("FTPc TX: %s", ctrl_buf));
+        rtn_code = FTPc_ProtReq(p_conn, p_conn->Prot, ctrl_buf, ctrl_buf_size, p_err);
         if (rtn_code == DEF_FAIL) {
-            *p_err = FTPc_ERR_TX_CMD;
-             goto exit_close_sock;
-        }
-
-                                                                /* Receive status line.                                 */
-        reply_code = FTPc_WaitForStatus(p_conn, 0, 0, &err);
-        if (reply_code != FTP_REPLY_CODE_OKAY) {
-            *p_err = FTPc_ERR_RX_CMD_RESP_FAIL;
              goto exit_close_sock;
         }
     }
 #endif
 
+    FTPc_STAT_TS(p_conn, TS_End);
    *p_err = FTPc_ERR_NONE;
 
     goto exit;
@@ -560,6 +795,9 @@ CPU_BOOLEAN  FTPc_Open (      FTPc_CONN        *p_conn,
 exit_close_sock:
     NetSock_Close(p_conn->SockID, &err);
     p_conn->SockID = NET_SOCK_ID_NONE;
+#ifdef  NET_SECURE_MODULE_EN
+    FTPc_SecureSessionFree(p_conn);
+#endif
     rtn_code = DEF_FAIL;
 
 exit:
@@ -578,6 +816,7 @@ exit:
 *               p_err       Pointer to variable that will receive the return error code from this function :
 *
 *                               FTPc_ERR_NONE                   Connection closing was successful.
+*                               FTPc_ERR_CMD_LEN                Command longer than control buffer.
 *                               FTPc_ERR_TX_CMD                 Sending Command failed.
 *                               FTPc_ERR_RX_CMD_RESP_FAIL       Receiving Command response failed.
 *
@@ -593,31 +832,18 @@ exit:
 CPU_BOOLEAN  FTPc_Close (FTPc_CONN  *p_conn,
                          FTPc_ERR   *p_err)
 {
-    const  FTPc_CFG     *p_cfg;
-           CPU_CHAR      ctrl_buf[FTPc_CTRL_NET_BUF_SIZE];
-           CPU_INT32U    ctrl_buf_size;
-           CPU_INT32U    buf_size;
-           CPU_INT32U    reply_code;
-           CPU_BOOLEAN   rtn_code;
-           NET_ERR       err;
-
+    CPU_CHAR      ctrl_buf[FTPc_CTRL_NET_BUF_SIZE];
+    CPU_INT32U    ctrl_buf_size;
+    CPU_INT32U    reply_code;
+    CPU_BOOLEAN   rtn_code;
+    NET_ERR       err;
 
-    p_cfg = FTPc_CfgPtr;
 
     ctrl_buf_size = sizeof(ctrl_buf);
                                                                 /* Send QUIT command.                                   */
-    buf_size = Str_FmtPrint((char *)ctrl_buf, ctrl_buf_size, "%s\r\n", FTPc_Cmd[FTP_CMD_QUIT].CmdStr);
-    rtn_code = FTPc_Tx(p_conn->SockID,
-                       ctrl_buf,
-                       buf_size,
-                       p_cfg->CtrlTxMaxTimout_ms,
-                       p_cfg->CtrlTxMaxRetry,
-                       p_cfg->CtrlTxMaxDly_ms,
-                      &err);
-    FTPc_TRACE_INFO(("FTPc TX: %s", ctrl_buf));
+    rtn_code = FTPc_CmdTx(p_conn, FTP_CMD_QUIT, DEF_NULL, ctrl_buf, ctrl_buf_size, p_err);
     if (rtn_code == DEF_FAIL) {
         FTPc_TRACE_INFO(("FTPc CLOSE CTRL socket.\n"));
-       *p_err    = FTPc_ERR_TX_CMD;
         rtn_code = DEF_FAIL;
         goto exit;
     }
@@ -638,6 +864,9 @@ CPU_BOOLEAN  FTPc_Close (FTPc_CONN  *p_conn,
 exit:                                                           /* Close socket.                                        */
     NetSock_Close(p_conn->SockID, &err);
     FTPc_TRACE_INFO(("FTPc CLOSE CTRL socket.\n"));
+#ifdef  NET_SECURE_MODULE_EN
+    FTPc_SecureSessionFree(p_conn);
+#endif
 
    (void)err;
 
@@ -664,16 +893,19 @@ exit:                                                           /* Close socket.
 *               p_err       Pointer to variable that will receive the return error code from this function :
 *
 *                               FTPc_ERR_NONE                   Received file successfully.
+*                               FTPc_ERR_CMD_LEN                Command longer than control buffer.
 *                               FTPc_ERR_TX_CMD                 Sending Command failed.
 *                               FTPc_ERR_RX_CMD_RESP_FAIL       Receiving Command response failed.
 *                               FTPc_ERR_FILE_BUF_LEN           Invalid buffer length.
+*                               FTPc_ERR_RX_TIMEOUT             Data connection stalled.
+*                               FTPc_ERR_CONN_FAIL              Data connection failed.
 *
 * Return(s)   : DEF_FAIL        reception failed.
 *               DEF_OK          reception successful.
 *
 * Caller(s)   : Application.
 *
-* Note(s)     : None.
+* Note(s)     : (1) See FTPc_RecvBufChain().
 *********************************************************************************************************
 */
 
@@ -684,82 +916,156 @@ CPU_BOOLEAN  FTPc_RecvBuf (FTPc_CONN   *p_conn,
                            CPU_INT32U  *p_file_size,
                            FTPc_ERR    *p_err)
 {
-    const  FTPc_CFG         *p_cfg;
-           NET_SOCK_ID       sock_dtp_id;
-           CPU_CHAR          ctrl_buf[FTPc_CTRL_NET_BUF_SIZE];
-           CPU_INT32U        ctrl_buf_size;
-           CPU_INT32U        buf_size;
-           CPU_INT32U        reply_code;
-           CPU_BOOLEAN       rtn_code;
-           CPU_INT32U        rx_pkt_cnt;
-           CPU_CHAR         *tmp_buf;
-           CPU_INT32S        tmp_val;
-           CPU_INT32U        rx_len;
-           CPU_INT32U        bytes_recv;
-           CPU_INT32U        got_file_size;
-           NET_ERR           err;
+    FTPc_BUF_SEG  seg;
+    CPU_BOOLEAN   rtn_code;
 
 
-    p_cfg = FTPc_CfgPtr;
+    seg.DataPtr = p_buf;
+    seg.Len     = buf_len;
 
-    ctrl_buf_size = sizeof(ctrl_buf);
-                                                                /* Send TYPE command.                                   */
-    buf_size = Str_FmtPrint((char *)ctrl_buf, ctrl_buf_size, "%s %c\r\n", FTPc_Cmd[FTP_CMD_TYPE].CmdStr, FTP_TYPE_IMAGE);
-    rtn_code = FTPc_Tx(p_conn->SockID,
-                       ctrl_buf,
-                       buf_size,
-                       p_cfg->CtrlTxMaxTimout_ms,
-                       p_cfg->CtrlTxMaxRetry,
-                       p_cfg->CtrlTxMaxDly_ms,
-                      &err);
-    FTPc_TRACE_INFO(("FTPc TX: %s", ctrl_buf));
-    if (rtn_code == DEF_FAIL) {
-       *p_err = FTPc_ERR_TX_CMD;
-        rtn_code = DEF_FAIL;
-        goto exit;
+    rtn_code    = FTPc_RecvBufChain(p_conn,
+                                    p_remote_file_name,
+                                   &seg,
+                                    1u,
+                                    p_file_size,
+                                    p_err);
+
+    return (rtn_code);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FTPc_RecvBufChain()
+*
+* Description : Receive a file from an FTP server into a chain of memory buffer segments.
+*
+* Argument(s) : p_conn              Pointer to FTPc Connection object.
+*
+*               remote_file_name    Pointer to name of the file in FTP server.
+*
+*               p_seg_tbl           Pointer to table of buffer segments to fill, in order (see Note #4).
+*
+*               seg_nbr             Number of buffer segments in table.
+*
+*               p_file_size         Variable that will received the size of the file received.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FTPc_ERR_NONE                   Received file successfully.
+*                               FTPc_ERR_FAULT_NULL_PTR         Invalid segment table.
+*                               FTPc_ERR_CMD_LEN                Command longer than control buffer.
+*                               FTPc_ERR_TX_CMD                 Sending Command failed.
+*                               FTPc_ERR_RX_CMD_RESP_FAIL       Receiving Command response failed.
+*                               FTPc_ERR_FILE_BUF_LEN           File larger than the buffer segments.
+*                               FTPc_ERR_RX_TIMEOUT             Data connection stalled.
+*                               FTPc_ERR_CONN_FAIL              Data connection failed.
+*
+* Return(s)   : DEF_FAIL        reception failed.
+*               DEF_OK          reception successful.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) The transfer ends as soon as the size returned by the SIZE command is received or the
+*                   server closes the data connection (see FTPc_DTP_Rx() Note #1).
+*
+*               (2) In ASCII mode, the SIZE command is not sent since its result does not match the
+*                   size of the data transferred. The segments MUST then be large enough for the received
+*                   file. Once all segments are full, one more octet is read from the data connection to
+*                   tell a file that exactly fills the segments from a larger one.
+*
+*               (3) In ASCII mode, CRLF sequences are converted to LF as data is received (see
+*                   FTPc_AsciiRxConv()). A pending CR that ends a full segment is moved to the start of
+*                   the next segment, which leaves the last octet of the segment unused.
+*
+*               (4) Each segment is filled with Len octets at most & its LenUsed field receives the number
+*                   of octets stored in it. Segments are filled in order so that the file is the
+*                   concatenation of the used part of each segment.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  FTPc_RecvBufChain (FTPc_CONN     *p_conn,
+                                CPU_CHAR      *p_remote_file_name,
+                                FTPc_BUF_SEG  *p_seg_tbl,
+                                CPU_SIZE_T     seg_nbr,
+                                CPU_INT32U    *p_file_size,
+                                FTPc_ERR      *p_err)
+{
+    NET_SOCK_ID       sock_dtp_id;
+    CPU_CHAR          ctrl_buf[FTPc_CTRL_NET_BUF_SIZE];
+    CPU_INT32U        ctrl_buf_size;
+    CPU_INT32U        reply_code;
+    CPU_BOOLEAN       rtn_code;
+    CPU_BOOLEAN       xfer_open;
+    CPU_INT32U        rx_pkt_cnt;
+    CPU_CHAR         *tmp_buf;
+    CPU_INT32S        tmp_val;
+    CPU_INT32U        rx_len;
+    CPU_INT32U        cr_len;
+    CPU_INT32U        bytes_recv;
+    CPU_INT32U        file_size;
+    CPU_INT32U        got_file_size;
+    CPU_INT32U        seg_len_tot;
+    CPU_SIZE_T        seg_ix;
+    CPU_SIZE_T        seg_next;
+    FTPc_BUF_SEG     *p_seg;
+    CPU_CHAR          rx_probe;
+    NET_ERR           err;
+
+
+    if ((p_seg_tbl == DEF_NULL) ||
+        (seg_nbr   == 0u)) {
+       *p_err = FTPc_ERR_FAULT_NULL_PTR;
+        return (DEF_FAIL);
     }
 
-                                                                /* Receive status line.                                 */
-    reply_code = FTPc_WaitForStatus(p_conn, 0, 0, &err);
-    if (reply_code != FTP_REPLY_CODE_OKAY) {
-       *p_err = FTPc_ERR_RX_CMD_RESP_FAIL;
-        rtn_code = DEF_FAIL;
-        goto exit;
+    seg_len_tot = 0u;
+    for (seg_ix = 0u; seg_ix < seg_nbr; seg_ix++) {
+        p_seg_tbl[seg_ix].LenUsed  = 0u;
+        seg_len_tot               += p_seg_tbl[seg_ix].Len;
     }
-                                                                /* Send SIZE command.                                   */
-    buf_size = Str_FmtPrint((char *)ctrl_buf, ctrl_buf_size, "%s %s\r\n", FTPc_Cmd[FTP_CMD_SIZE].CmdStr, p_remote_file_name);
-    rtn_code = FTPc_Tx(p_conn->SockID,
-                       ctrl_buf,
-                       buf_size,
-                       p_cfg->CtrlTxMaxTimout_ms,
-                       p_cfg->CtrlTxMaxRetry,
-                       p_cfg->CtrlTxMaxDly_ms,
-                      &err);
-    FTPc_TRACE_INFO(("FTPc TX: %s", ctrl_buf));
+
+    FTPc_STAT_RESET(p_conn);
+    FTPc_STAT_TS(p_conn, TS_Start);
+
+    p_conn->AsciiCR = DEF_NO;
+    ctrl_buf_size   = sizeof(ctrl_buf);
+                                                                /* Set data type.                                       */
+    rtn_code = FTPc_TypeReq(p_conn, p_conn->Type, ctrl_buf, ctrl_buf_size, p_err);
     if (rtn_code == DEF_FAIL) {
-       *p_err    = FTPc_ERR_TX_CMD;
-        rtn_code = DEF_FAIL;
-        goto exit;
-    }
-                                                                /* Receive status line.                                 */
-    reply_code = FTPc_WaitForStatus(p_conn, ctrl_buf, ctrl_buf_size, &err);
-    if (reply_code != FTP_REPLY_CODE_FILESTATUS) {
-       *p_err    = FTPc_ERR_RX_CMD_RESP_FAIL;
-        rtn_code = DEF_FAIL;
         goto exit;
     }
 
-    tmp_buf       = ctrl_buf;
-    tmp_val       = Str_ParseNbr_Int32S(tmp_buf, &tmp_buf, 10);/* Skip result code.                                    */
-    tmp_buf++;
+    got_file_size = DEF_INT_32U_MAX_VAL;                        /* See Note #2.                                         */
+    if (p_conn->Type != FTP_TYPE_ASCII) {
+                                                                /* Send SIZE command.                                   */
+        rtn_code = FTPc_CmdTx(p_conn, FTP_CMD_SIZE, p_remote_file_name, ctrl_buf, ctrl_buf_size, p_err);
+        if (rtn_code == DEF_FAIL) {
+            rtn_code = DEF_FAIL;
+            goto exit;
+        }
+                                                                /* Receive status line.                                 */
+        reply_code = FTPc_WaitForStatus(p_conn, ctrl_buf, ctrl_buf_size, &err);
+        if (reply_code != FTP_REPLY_CODE_FILESTATUS) {
+           *p_err    = FTPc_ERR_RX_CMD_RESP_FAIL;
+            rtn_code = DEF_FAIL;
+            goto exit;
+        }
 
-    tmp_val       = Str_ParseNbr_Int32S(tmp_buf, &tmp_buf, 10);/* Get file size.                                       */
-    tmp_buf++;
-    got_file_size = tmp_val;
-    if (got_file_size > buf_len) {
-       *p_err    = FTPc_ERR_FILE_BUF_LEN;
-        rtn_code = DEF_FAIL;
-        goto exit;
+        tmp_buf       = ctrl_buf;
+                                                                /* Skip result code.                                    */
+        tmp_val       = Str_ParseNbr_Int32S(tmp_buf, &tmp_buf, 10);
+        tmp_buf++;
+
+                                                                /* Get file size.                                       */
+        tmp_val       = Str_ParseNbr_Int32S(tmp_buf, &tmp_buf, 10);
+        tmp_buf++;
+        got_file_size = tmp_val;
+        if (got_file_size > seg_len_tot) {
+           *p_err    = FTPc_ERR_FILE_BUF_LEN;
+            rtn_code = DEF_FAIL;
+            goto exit;
+        }
     }
 
 
@@ -769,18 +1075,10 @@ CPU_BOOLEAN  FTPc_RecvBuf (FTPc_CONN   *p_conn,
         goto exit;
     }
 
+    xfer_open = DEF_NO;
                                                                 /* Send RETR command.                                   */
-    buf_size = Str_FmtPrint((char *)ctrl_buf, ctrl_buf_size, "%s %s\r\n", FTPc_Cmd[FTP_CMD_RETR].CmdStr, p_remote_file_name);
-    rtn_code = FTPc_Tx(p_conn->SockID,
-                       ctrl_buf,
-                       buf_size,
-                       p_cfg->CtrlTxMaxTimout_ms,
-                       p_cfg->CtrlTxMaxRetry,
-                       p_cfg->CtrlTxMaxDly_ms,
-                       &err);
-    FTPc_TRACE_INFO(("FTPc TX: %s", ctrl_buf));
+    rtn_code = FTPc_CmdTx(p_conn, FTP_CMD_RETR, p_remote_file_name, ctrl_buf, ctrl_buf_size, p_err);
     if (rtn_code == DEF_FAIL) {
-       *p_err = FTPc_ERR_TX_CMD;
         rtn_code = DEF_FAIL;
         goto exit_close_dtp_sock;
     }
@@ -793,67 +1091,83 @@ CPU_BOOLEAN  FTPc_RecvBuf (FTPc_CONN   *p_conn,
         rtn_code = DEF_FAIL;
         goto exit_close_dtp_sock;
     }
+    FTPc_STAT_TS(p_conn, TS_XferCmd);
+    xfer_open = DEF_YES;
 
-    NetSock_CfgTimeoutRxQ_Set(sock_dtp_id, p_cfg->DTP_RxMaxTimout_ms, &err);
+    NetSock_CfgTimeoutRxQ_Set(sock_dtp_id, FTPc_DTP_RX_POLL_MS, &err);
 
+    seg_ix     = 0u;
     bytes_recv = 0;
+    file_size  = 0;
     rx_pkt_cnt = 0;
-    while (bytes_recv < got_file_size) {
+    cr_len     = 0;
+    while ((file_size + cr_len) < got_file_size) {              /* Rx until known size is rx'd ...                      */
+        p_seg = &p_seg_tbl[seg_ix];
+        if ((bytes_recv + cr_len) >= p_seg->Len) {              /* If seg full, move to next non-empty seg.             */
+            seg_next = seg_ix + 1u;
+            while ((seg_next                < seg_nbr) &&
+                   (p_seg_tbl[seg_next].Len == 0u    )) {
+                seg_next++;
+            }
+            if (seg_next >= seg_nbr) {                          /* Probe for end-of-file (see Note #2).                 */
+                tmp_val = FTPc_DTP_Rx(p_conn, sock_dtp_id, &rx_probe, 1u, p_err);
+                if ((tmp_val  >  0           ) &&               /* LF ends pending ASCII CR (see Note #3).              */
+                    (cr_len   != 0u          ) &&
+                    (rx_probe == FTP_ASCII_LF)) {
+                    ((CPU_CHAR *)p_seg->DataPtr)[bytes_recv] = FTP_ASCII_LF;
+                    bytes_recv++;
+                    file_size++;
+                    cr_len          = 0u;
+                    p_conn->AsciiCR = DEF_NO;
+                    continue;
+                }
+                if (tmp_val > 0) {
+                   *p_err = FTPc_ERR_FILE_BUF_LEN;
+                }
+                break;
+            }
 
-        tmp_buf = ((CPU_CHAR *)p_buf) + bytes_recv;
-        rx_len  = got_file_size - bytes_recv;
+            p_seg->LenUsed = bytes_recv;
+            seg_ix         = seg_next;
+            bytes_recv     = 0;
+            if (cr_len != 0u) {                                 /* Move pending ASCII CR (see Note #3).                 */
+               *((CPU_CHAR *)p_seg_tbl[seg_ix].DataPtr) = FTP_ASCII_CR;
+            }
+            continue;
+        }
+                                                                /* Pending ASCII CR kept in front of data (see Note #3).*/
+        tmp_buf = ((CPU_CHAR *)p_seg->DataPtr) + bytes_recv + cr_len;
+        rx_len  = DEF_MIN(p_seg->Len    - bytes_recv - cr_len,
+                          got_file_size - file_size  - cr_len);
         if (rx_len > DEF_INT_16S_MAX_VAL) {
             rx_len = DEF_INT_16S_MAX_VAL;
         }
 
-        tmp_val = NetSock_RxData(sock_dtp_id, tmp_buf, rx_len, NET_SOCK_FLAG_NONE, &err);
-        if (tmp_val > 0) {
-            bytes_recv += tmp_val;
-        }
-        if ((err != NET_SOCK_ERR_NONE) &&
-            (err != NET_SOCK_ERR_RX_Q_EMPTY) &&
-            (err != NET_SOCK_ERR_RX_Q_CLOSED)) {
-             FTPc_TRACE_DBG(("FTPc NetSock_RxData() failed: error #%u, line #%u.\n", (unsigned int)err, (unsigned int)__LINE__));
-             break;
+        tmp_val = FTPc_DTP_Rx(p_conn, sock_dtp_id, tmp_buf, (CPU_INT16U)rx_len, p_err);
+        if (tmp_val <= 0) {                                     /* ... or until end-of-file or err.                     */
+            break;
         }
 
-        FTPc_TRACE_DBG(("FTPc RX DATA #%03u.\n", rx_pkt_cnt));
-
-                                                                /* In this case, a timeout represents an end-of-file    */
-                                                                /* condition.                                           */
-        if ((err == NET_SOCK_ERR_RX_Q_EMPTY) ||
-            (err == NET_SOCK_ERR_RX_Q_CLOSED)) {
-             break;
+        FTPc_TRACE_EVT(FTPc_TRACE_EVT_DTP_RX, rx_pkt_cnt, tmp_val);
+        FTPc_STAT_TS_FIRST(p_conn, TS_FirstByte);
+        FTPc_STAT_ADD(p_conn, RxBytes, tmp_val);
+        FTPc_HIST_XFER_ADD(p_conn, tmp_val);
+        rx_len = (CPU_INT32U)tmp_val;
+        if (p_conn->Type == FTP_TYPE_ASCII) {
+            rx_len = FTPc_AsciiRxConv(p_conn, ((CPU_CHAR *)p_seg->DataPtr) + bytes_recv, rx_len + cr_len);
+            cr_len = (p_conn->AsciiCR == DEF_YES) ? 1u : 0u;
         }
+        bytes_recv += rx_len;
+        file_size  += rx_len;
         rx_pkt_cnt++;
     }
-
-
-   *p_file_size = got_file_size;
+    FTPc_STAT_TS(p_conn, TS_LastByte);
+                                                                /* Keep trailing ASCII CR.                              */
+    p_seg_tbl[seg_ix].LenUsed = bytes_recv + cr_len;
+   *p_file_size               = file_size  + cr_len;
 
 exit_close_dtp_sock:
-                                                                /* Close socket.                                        */
-    NetSock_Close(sock_dtp_id, &err);
-    FTPc_TRACE_INFO(("FTPc CLOSE DTP socket.\n"));
-
-
-    if (*p_err == FTPc_ERR_NONE) {
-                                                                /* Receive status line.                                 */
-        reply_code = FTPc_WaitForStatus(p_conn, 0, 0, &err);
-        if (reply_code != FTP_REPLY_CODE_CLOSINGSUCCESS) {
-           *p_err = FTPc_ERR_RX_CMD_RESP_FAIL;
-            rtn_code = DEF_FAIL;
-            goto exit;
-        }
-
-        rtn_code = DEF_OK;
-
-    } else {
-        goto exit;
-    }
-
-
-   *p_err = FTPc_ERR_NONE;
+    rtn_code = FTPc_XferEnd(p_conn, sock_dtp_id, xfer_open, ctrl_buf, ctrl_buf_size, p_err);
 
 exit:
     return (rtn_code);
@@ -883,6 +1197,7 @@ exit:
 *               p_err       Pointer to variable that will receive the return error code from this function :
 *
 *                               FTPc_ERR_NONE                   Transmission was successful.
+*                               FTPc_ERR_CMD_LEN                Command longer than control buffer.
 *                               FTPc_ERR_TX_CMD                 Sending Command failed.
 *                               FTPc_ERR_RX_CMD_RESP_FAIL       Receiving Command response failed.
 *
@@ -902,42 +1217,111 @@ CPU_BOOLEAN  FTPc_SendBuf (FTPc_CONN    *p_conn,
                            CPU_BOOLEAN   append,
                            FTPc_ERR     *p_err)
 {
-    const  FTPc_CFG     *p_cfg;
-           NET_SOCK_ID   sock_dtp_id;
-           CPU_CHAR      ctrl_buf[FTPc_CTRL_NET_BUF_SIZE];
-           CPU_INT32U    ctrl_buf_size;
-           CPU_INT32U    buf_size;
+    FTPc_BUF_SEG  seg;
+    CPU_BOOLEAN   rtn_code;
+
+
+    seg.DataPtr = p_buf;
+    seg.Len     = buf_len;
+
+    rtn_code    = FTPc_SendBufVect(p_conn,
+                                   p_remote_file_name,
+                                  &seg,
+                                   1u,
+                                   append,
+                                   p_err);
+
+    return (rtn_code);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          FTPc_SendBufVect()
+*
+* Description : Send a vector of memory buffer segments to an FTP server, as a single file.
+*
+* Argument(s) : p_conn              Pointer to FTPc Connection object.
+*
+*               p_remote_file_name  Pointer to name of the file in FTP server.
+*
+*               p_seg_tbl           Pointer to table of buffer segments to send, in order.
+*
+*               seg_nbr             Number of buffer segments in table.
+*
+*               append              if DEF_YES, existing file on FTP server will be appended with
+*                                       memory buffer. If file doesn't exist on FTP server, it will be
+*                                       created.
+*                                   if DEF_NO, existing file on FTP server will be overwritten.
+*                                       If file doesn't exist on FTP server, it will be created.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FTPc_ERR_NONE                   Transmission was successful.
+*                               FTPc_ERR_FAULT_NULL_PTR         Invalid segment table.
+*                               FTPc_ERR_CMD_LEN                Command longer than control buffer.
+*                               FTPc_ERR_TX_CMD                 Sending Command failed.
+*                               FTPc_ERR_RX_CMD_RESP_FAIL       Receiving Command response failed.
+*                               FTPc_ERR_CONN_FAIL              Data connection failed.
+*
+* Return(s)   : DEF_FAIL        transmission failed.
+*               DEF_OK          transmission successful.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) In ASCII mode, LF line endings are converted to CRLF through an intermediate buffer
+*                   (see FTPc_AsciiTxConv()). Otherwise, segments are transmitted directly from their
+*                   memory buffers over a single data connection.
+*
+*               (2) A transmit error on the data connection aborts the transfer (see FTPc_XferEnd()
+*                   Note #3), so that the server does not store a partial file.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  FTPc_SendBufVect (      FTPc_CONN     *p_conn,
+                                     CPU_CHAR      *p_remote_file_name,
+                               const FTPc_BUF_SEG  *p_seg_tbl,
+                                     CPU_SIZE_T     seg_nbr,
+                                     CPU_BOOLEAN    append,
+                                     FTPc_ERR      *p_err)
+{
+    const  FTPc_CFG     *p_cfg;
+           NET_SOCK_ID   sock_dtp_id;
+           CPU_CHAR      ctrl_buf[FTPc_CTRL_NET_BUF_SIZE];
+           CPU_INT32U    ctrl_buf_size;
+           CPU_INT32U    buf_size;
            CPU_INT32U    reply_code;
            CPU_BOOLEAN   rtn_code;
+           CPU_BOOLEAN   xfer_open;
+           CPU_SIZE_T    seg_ix;
+           CPU_INT08U   *p_buf;
+           CPU_INT32U    buf_len;
            CPU_INT32U    bytes_sent;
            CPU_INT32U    tx_pkt_cnt;
+           CPU_CHAR      data_buf[FTPc_DTP_NET_BUF_SIZE];
+           CPU_CHAR     *p_tx_buf;
+           CPU_SIZE_T    tx_len;
+           CPU_SIZE_T    src_len;
            NET_ERR       err;
 
 
-    p_cfg = FTPc_CfgPtr;
-
-    ctrl_buf_size = sizeof(ctrl_buf);
-                                                                /* Send TYPE command.                                   */
-    buf_size = Str_FmtPrint((char *)ctrl_buf, ctrl_buf_size, "%s %c\r\n", FTPc_Cmd[FTP_CMD_TYPE].CmdStr, FTP_TYPE_IMAGE);
-    rtn_code = FTPc_Tx(p_conn->SockID,
-                       ctrl_buf,
-                       buf_size,
-                       p_cfg->CtrlTxMaxTimout_ms,
-                       p_cfg->CtrlTxMaxRetry,
-                       p_cfg->CtrlTxMaxDly_ms,
-                      &err);
-    FTPc_TRACE_INFO(("FTPc TX: %s", ctrl_buf));
-    if (rtn_code == DEF_FAIL) {
-       *p_err    = FTPc_ERR_TX_CMD;
-        rtn_code = DEF_FAIL;
-        goto exit;
+    if ((p_seg_tbl == DEF_NULL) &&
+        (seg_nbr   >  0u)) {
+       *p_err = FTPc_ERR_FAULT_NULL_PTR;
+        return (DEF_FAIL);
     }
 
-                                                                /* Receive status line.                                 */
-    reply_code = FTPc_WaitForStatus(p_conn, 0, 0, &err);
-    if (reply_code != FTP_REPLY_CODE_OKAY) {
-       *p_err    = FTPc_ERR_RX_CMD_RESP_FAIL;
-        rtn_code = DEF_FAIL;
+    p_cfg = p_conn->CfgPtr;
+
+    FTPc_STAT_RESET(p_conn);
+    FTPc_STAT_TS(p_conn, TS_Start);
+    FTPc_META_CACHE_INV(p_conn, p_remote_file_name);            /* Remote file is about to change.                      */
+
+    p_conn->AsciiCR = DEF_NO;
+    ctrl_buf_size   = sizeof(ctrl_buf);
+                                                                /* Set data type.                                       */
+    rtn_code = FTPc_TypeReq(p_conn, p_conn->Type, ctrl_buf, ctrl_buf_size, p_err);
+    if (rtn_code == DEF_FAIL) {
         goto exit;
     }
 
@@ -947,36 +1331,19 @@ CPU_BOOLEAN  FTPc_SendBuf (FTPc_CONN    *p_conn,
          goto exit;
     }
 
+    xfer_open = DEF_NO;
 
     if (append == DEF_YES) {
                                                                 /* Send APPE command.                                   */
-        buf_size = Str_FmtPrint((char *)ctrl_buf, ctrl_buf_size, "%s %s\r\n", FTPc_Cmd[FTP_CMD_APPE].CmdStr, p_remote_file_name);
-        rtn_code = FTPc_Tx(p_conn->SockID,
-                           ctrl_buf,
-                           buf_size,
-                           p_cfg->CtrlTxMaxTimout_ms,
-                           p_cfg->CtrlTxMaxRetry,
-                           p_cfg->CtrlTxMaxDly_ms,
-                           &err);
-        FTPc_TRACE_INFO(("FTPc TX: %s", ctrl_buf));
+        rtn_code = FTPc_CmdTx(p_conn, FTP_CMD_APPE, p_remote_file_name, ctrl_buf, ctrl_buf_size, p_err);
         if (rtn_code == DEF_FAIL) {
-            *p_err    = FTPc_ERR_TX_CMD;
              rtn_code = DEF_FAIL;
              goto exit_close_dtp_sock;
         }
     } else {
                                                                 /* Send STOR command.                                   */
-        buf_size = Str_FmtPrint((char *)ctrl_buf, ctrl_buf_size, "%s %s\r\n", FTPc_Cmd[FTP_CMD_STOR].CmdStr, p_remote_file_name);
-        rtn_code = FTPc_Tx(p_conn->SockID,
-                           ctrl_buf,
-                           buf_size,
-                           p_cfg->CtrlTxMaxTimout_ms,
-                           p_cfg->CtrlTxMaxRetry,
-                           p_cfg->CtrlTxMaxDly_ms,
-                           &err);
-        FTPc_TRACE_INFO(("FTPc TX: %s", ctrl_buf));
+        rtn_code = FTPc_CmdTx(p_conn, FTP_CMD_STOR, p_remote_file_name, ctrl_buf, ctrl_buf_size, p_err);
         if (rtn_code == DEF_FAIL) {
-            *p_err    = FTPc_ERR_TX_CMD;
              rtn_code = DEF_FAIL;
              goto exit_close_dtp_sock;
         }
@@ -988,56 +1355,67 @@ CPU_BOOLEAN  FTPc_SendBuf (FTPc_CONN    *p_conn,
         rtn_code = DEF_FAIL;
         goto exit_close_dtp_sock;
     }
+    FTPc_STAT_TS(p_conn, TS_XferCmd);
+    xfer_open = DEF_YES;
 
-    NetSock_CfgTimeoutRxQ_Set(sock_dtp_id, p_cfg->DTP_TxMaxTimout_ms, &err);
-    bytes_sent = 0;
+    NetSock_CfgTimeoutTxQ_Set(sock_dtp_id, p_cfg->DTP_TxMaxTimout_ms, &err);
     tx_pkt_cnt = 0;
-    while (bytes_sent < buf_len) {
-        buf_size = buf_len - bytes_sent;
-        if (buf_size > FTPc_DTP_NET_BUF_SIZE) {
-            buf_size = FTPc_DTP_NET_BUF_SIZE;
-        }
-
-        FTPc_TRACE_DBG(("FTPc TX DATA #%03u... ", tx_pkt_cnt));
-        rtn_code = FTPc_Tx(            sock_dtp_id,
-                           (CPU_CHAR *)p_buf,
-                                       buf_size,
-                                       0,
-                                       p_cfg->DTP_TxMaxRetry,
-                                       p_cfg->DTP_TxMaxDly_ms,
-                                      &err);
+    for (seg_ix = 0u; seg_ix < seg_nbr; seg_ix++) {             /* Tx each seg in turn.                                 */
+        p_buf      = (CPU_INT08U *)p_seg_tbl[seg_ix].DataPtr;
+        buf_len    = p_seg_tbl[seg_ix].Len;
+        bytes_sent = 0;
+        while (bytes_sent < buf_len) {
+            buf_size = buf_len - bytes_sent;
+            if (buf_size > FTPc_DTP_NET_BUF_SIZE) {
+                buf_size = FTPc_DTP_NET_BUF_SIZE;
+            }
+
+            p_tx_buf = (CPU_CHAR *)p_buf;
+            tx_len   =  buf_size;
+            if (p_conn->Type == FTP_TYPE_ASCII) {               /* See Note #1.                                         */
+                p_tx_buf =  data_buf;
+                tx_len   =  FTPc_AsciiTxConv(            p_conn,
+                                             (CPU_CHAR *)p_buf,
+                                                         buf_len - bytes_sent,
+                                                         data_buf,
+                                                         sizeof(data_buf),
+                                                        &src_len);
+                buf_size = (CPU_INT32U)src_len;
+            }
+
+            rtn_code = FTPc_Tx(p_conn,
+                               sock_dtp_id,
+                               p_tx_buf,
+                               tx_len,
+                               0,
+                               p_cfg->DTP_TxMaxRetry,
+                               p_cfg->DTP_TxMaxDly_ms,
+                              &err);
+            if (rtn_code == DEF_FAIL) {
+                FTPc_TRACE_DBG(("FTPc FTPc_Tx() failed: error #%u, line #%u.\n", (unsigned int)err, (unsigned int)__LINE__));
+                FTPc_TRACE_EVT(FTPc_TRACE_EVT_DTP_TX_ERR, err, tx_pkt_cnt);
+               *p_err = FTPc_ERR_CONN_FAIL;                     /* See Note #2.                                         */
+                break;
+            }
+
+            FTPc_TRACE_EVT(FTPc_TRACE_EVT_DTP_TX, tx_pkt_cnt, tx_len);
+            FTPc_STAT_TS_FIRST(p_conn, TS_FirstByte);
+            FTPc_STAT_ADD(p_conn, TxBytes, tx_len);
+            FTPc_HIST_XFER_ADD(p_conn, tx_len);
+            FTPc_DTP_THROTTLE(p_conn, tx_len);
+            FTPc_SCHED_YIELD(p_conn);
+            bytes_sent += buf_size;
+            p_buf       += buf_size;
+            tx_pkt_cnt++;
+        }
         if (rtn_code == DEF_FAIL) {
-            FTPc_TRACE_DBG(("FTPc FTPc_Tx() failed: error #%u, line #%u.\n", (unsigned int)err, (unsigned int)__LINE__));
             break;
         }
-
-        FTPc_TRACE_DBG(("\n"));
-        bytes_sent += buf_size;
-        p_buf       += buf_size;
-        tx_pkt_cnt++;
     }
+    FTPc_STAT_TS(p_conn, TS_LastByte);
 
 exit_close_dtp_sock:
-                                                                /* Close socket.                                        */
-    NetSock_Close(sock_dtp_id, &err);
-    FTPc_TRACE_INFO(("FTPc CLOSE DTP socket.\n"));
-
-    if (*p_err == FTPc_ERR_NONE) {
-                                                                /* Receive status line.                                 */
-        reply_code = FTPc_WaitForStatus(p_conn, 0, 0, &err);
-        if (reply_code != FTP_REPLY_CODE_CLOSINGSUCCESS) {
-            *p_err = FTPc_ERR_RX_CMD_RESP_FAIL;
-             rtn_code = DEF_FAIL;
-             goto exit;
-         }
-
-         rtn_code = DEF_OK;
-
-     } else {
-         goto exit;
-     }
-
-   *p_err = FTPc_ERR_NONE;
+    rtn_code = FTPc_XferEnd(p_conn, sock_dtp_id, xfer_open, ctrl_buf, ctrl_buf_size, p_err);
 
 exit:
     return (rtn_code);
@@ -1059,18 +1437,26 @@ exit:
 *               p_err       Pointer to variable that will receive the return error code from this function :
 *
 *                               FTPc_ERR_NONE                   Reception of file was successful.
+*                               FTPc_ERR_CMD_LEN                Command longer than control buffer.
 *                               FTPc_ERR_TX_CMD                 Sending Command failed.
 *                               FTPc_ERR_RX_CMD_RESP_FAIL       Receiving Command response failed.
 *                               FTPc_ERR_FILE_NOT_FOUND         File of server not found.
 *                               FTPc_ERR_FAULT                  Reception faulted.
 *                               FTPc_ERR_FILE_OPEN_FAIL         File opening faulted on FS.
+*                               FTPc_ERR_FILE_WR_FAIL           File writing faulted on FS.
+*                               FTPc_ERR_RX_TIMEOUT             Data connection stalled.
+*                               FTPc_ERR_CONN_FAIL              Data connection failed.
 *
 * Return(s)   : DEF_FAIL        reception failed.
 *               DEF_OK          reception successful.
 *
 * Caller(s)   : Application.
 *
-* Note(s)     : None.
+* Note(s)     : (1) The transfer ends when the server closes the data connection (see FTPc_DTP_Rx()
+*                   Note #1).
+*
+*               (2) In ASCII mode, CRLF sequences are converted to LF as data is received (see
+*                   FTPc_AsciiRxConv()).
 *********************************************************************************************************
 */
 
@@ -1080,68 +1466,46 @@ CPU_BOOLEAN  FTPc_RecvFile (FTPc_CONN  *p_conn,
                             FTPc_ERR   *p_err)
 {
 #if (FTPc_CFG_USE_FS > 0)
-    const  FTPc_CFG     *p_cfg;
-           NET_SOCK_ID   sock_dtp_id;
-           CPU_CHAR      data_buf[FTPc_DTP_NET_BUF_SIZE];
-           CPU_CHAR      ctrl_buf[FTPc_CTRL_NET_BUF_SIZE];
-           CPU_INT32U    ctrl_buf_size;
-           CPU_INT32U    buf_size;
-           CPU_INT32U    reply_code;
-           CPU_BOOLEAN   rtn_code;
-           CPU_INT32U    rx_pkt_cnt;
-           void         *p_file;
-           CPU_SIZE_T    fs_len;
-           NET_ERR       err;
-
-
-    p_cfg = FTPc_CfgPtr;
+    NET_SOCK_ID   sock_dtp_id;
+    CPU_CHAR      data_buf[FTPc_DTP_NET_BUF_SIZE];
+    CPU_CHAR      ctrl_buf[FTPc_CTRL_NET_BUF_SIZE];
+    CPU_INT32U    ctrl_buf_size;
+    CPU_INT32U    buf_size;
+    CPU_INT32U    reply_code;
+    CPU_BOOLEAN   rtn_code;
+    CPU_BOOLEAN   xfer_open;
+    CPU_INT32U    rx_pkt_cnt;
+    CPU_INT32S    rx_len;
+    CPU_SIZE_T    cr_len;
+    void         *p_file;
+    CPU_SIZE_T    fs_len;
+    NET_ERR       err;
+
+
+    FTPc_STAT_RESET(p_conn);
+    FTPc_STAT_TS(p_conn, TS_Start);
 
    *p_err = FTPc_ERR_NONE;
 
-    ctrl_buf_size = sizeof(ctrl_buf);
-                                                                /* Send TYPE command.                                   */
-    buf_size = Str_FmtPrint((char *)ctrl_buf, ctrl_buf_size, "%s %c\r\n", FTPc_Cmd[FTP_CMD_TYPE].CmdStr, FTP_TYPE_IMAGE);
-    rtn_code = FTPc_Tx(p_conn->SockID,
-                       ctrl_buf,
-                       buf_size,
-                       p_cfg->CtrlTxMaxTimout_ms,
-                       p_cfg->CtrlTxMaxRetry,
-                       p_cfg->CtrlTxMaxDly_ms,
-                      &err);
-    FTPc_TRACE_INFO(("FTPc TX: %s", ctrl_buf));
+    p_conn->AsciiCR = DEF_NO;
+    ctrl_buf_size   = sizeof(ctrl_buf);
+                                                                /* Set data type.                                       */
+    rtn_code = FTPc_TypeReq(p_conn, p_conn->Type, ctrl_buf, ctrl_buf_size, p_err);
     if (rtn_code == DEF_FAIL) {
-       *p_err    = FTPc_ERR_TX_CMD;
-        rtn_code = DEF_FAIL;
         goto exit;
     }
 
-                                                                /* Receive status line.                                 */
-    reply_code = FTPc_WaitForStatus(p_conn, 0, 0, &err);
-    if (reply_code != FTP_REPLY_CODE_OKAY) {
-        *p_err    = FTPc_ERR_RX_CMD_RESP_FAIL;
-         rtn_code = DEF_FAIL;
-         goto exit;
-    }
-
     sock_dtp_id = FTPc_Conn(p_conn, ctrl_buf, ctrl_buf_size, p_err);
     if (sock_dtp_id == NET_SOCK_ID_NONE) {
         rtn_code = DEF_FAIL;
         goto exit;
     }
 
+    xfer_open = DEF_NO;
 
                                                                 /* Send RETR command.                                   */
-    buf_size = Str_FmtPrint((char *)ctrl_buf, ctrl_buf_size, "%s %s\r\n", FTPc_Cmd[FTP_CMD_RETR].CmdStr, p_remote_file_name);
-    rtn_code = FTPc_Tx(p_conn->SockID,
-                       ctrl_buf,
-                       buf_size,
-                       p_cfg->CtrlTxMaxTimout_ms,
-                       p_cfg->CtrlTxMaxRetry,
-                       p_cfg->CtrlTxMaxDly_ms,
-                       &err);
-    FTPc_TRACE_INFO(("FTPc TX: %s", ctrl_buf));
+    rtn_code = FTPc_CmdTx(p_conn, FTP_CMD_RETR, p_remote_file_name, ctrl_buf, ctrl_buf_size, p_err);
     if (rtn_code == DEF_FAIL) {
-        *p_err    = FTPc_ERR_TX_CMD;
          rtn_code = DEF_FAIL;
          goto exit_close_dtp_sock;
     }
@@ -1162,6 +1526,8 @@ CPU_BOOLEAN  FTPc_RecvFile (FTPc_CONN  *p_conn,
              rtn_code = DEF_FAIL;
              goto exit_close_dtp_sock;
     }
+    FTPc_STAT_TS(p_conn, TS_XferCmd);
+    xfer_open = DEF_YES;
 
 
     p_file = NetFS_FileOpen(p_local_file_name,
@@ -1175,26 +1541,25 @@ CPU_BOOLEAN  FTPc_RecvFile (FTPc_CONN  *p_conn,
     }
 
     NetSock_CfgTimeoutRxQ_Set(sock_dtp_id,
-                              p_cfg->DTP_RxMaxTimout_ms,
+                              FTPc_DTP_RX_POLL_MS,
                               &err);
 
     rx_pkt_cnt = 0;
-    while (DEF_TRUE) {
-        buf_size = NetSock_RxData(sock_dtp_id, data_buf, sizeof(data_buf), NET_SOCK_FLAG_NONE, &err);
-        if ((err != NET_SOCK_ERR_NONE) &&
-            (err != NET_SOCK_ERR_RX_Q_EMPTY) &&
-            (err != NET_SOCK_ERR_RX_Q_CLOSED)) {
-              FTPc_TRACE_DBG(("FTPc NetSock_RxData() failed: error #%u, line #%u.\n", (unsigned int)err, (unsigned int)__LINE__));
-              break;
+    cr_len     = 0u;
+    while (DEF_TRUE) {                                          /* Pending ASCII CR kept in front of data (see Note #2).*/
+        rx_len = FTPc_DTP_Rx(p_conn, sock_dtp_id, &data_buf[cr_len], sizeof(data_buf) - cr_len, p_err);
+        if (rx_len <= 0) {                                      /* End-of-file or err.                                  */
+            break;
         }
 
-        FTPc_TRACE_DBG(("FTPc RX DATA #%03u.\n", rx_pkt_cnt));
+        FTPc_TRACE_EVT(FTPc_TRACE_EVT_DTP_RX, rx_pkt_cnt, rx_len);
+        FTPc_STAT_TS_FIRST(p_conn, TS_FirstByte);
+        FTPc_STAT_ADD(p_conn, RxBytes, rx_len);
+        FTPc_HIST_XFER_ADD(p_conn, rx_len);
 
-                                                                /* In this case, a timeout represents an end-of-file    */
-                                                                /* condition.                                           */
-        if ((err == NET_SOCK_ERR_RX_Q_EMPTY) ||
-            (err == NET_SOCK_ERR_RX_Q_CLOSED)) {
-             break;
+        buf_size = (CPU_INT32U)rx_len;
+        if (p_conn->Type == FTP_TYPE_ASCII) {
+            buf_size = FTPc_AsciiRxConv(p_conn, data_buf, buf_size + cr_len);
         }
 
        (void)NetFS_FileWr( p_file,
@@ -1203,36 +1568,34 @@ CPU_BOOLEAN  FTPc_RecvFile (FTPc_CONN  *p_conn,
                           &fs_len);
         if (fs_len != buf_size) {
             FTPc_TRACE_DBG(("FTPc NetFS_FileWr() failed, line #%u.\n", (unsigned int)__LINE__));
+           *p_err = FTPc_ERR_FILE_WR_FAIL;
             break;
         }
+
+        cr_len = 0u;
+        if (p_conn->AsciiCR == DEF_YES) {
+            data_buf[0] = FTP_ASCII_CR;
+            cr_len      = 1u;
+        }
         rx_pkt_cnt++;
     }
+    FTPc_STAT_TS(p_conn, TS_LastByte);
 
-    NetFS_FileClose(p_file);
-
-exit_close_dtp_sock:
-                                                                /* Close socket.                                        */
-    NetSock_Close(sock_dtp_id, &err);
-    FTPc_TRACE_INFO(("FTPc CLOSE DTP socket.\n"));
-
-
-    if (*p_err == FTPc_ERR_NONE) {
-                                                                /* Receive status line.                                 */
-        reply_code = FTPc_WaitForStatus(p_conn, 0, 0, &err);
-        if (reply_code != FTP_REPLY_CODE_CLOSINGSUCCESS) {
-           *p_err = FTPc_ERR_RX_CMD_RESP_FAIL;
-            rtn_code = DEF_FAIL;
-            goto exit;
+    if ((*p_err == FTPc_ERR_NONE) &&                            /* Wr trailing ASCII CR.                                */
+        (cr_len != 0u)) {
+       (void)NetFS_FileWr( p_file,
+                           data_buf,
+                           cr_len,
+                          &fs_len);
+        if (fs_len != cr_len) {
+           *p_err = FTPc_ERR_FILE_WR_FAIL;
         }
-
-        rtn_code = DEF_OK;
-
-    } else {
-        goto exit;
     }
 
+    NetFS_FileClose(p_file);
 
-   *p_err = FTPc_ERR_NONE;
+exit_close_dtp_sock:
+    rtn_code = FTPc_XferEnd(p_conn, sock_dtp_id, xfer_open, ctrl_buf, ctrl_buf_size, p_err);
 
 exit:
     return (rtn_code);
@@ -1263,6 +1626,7 @@ exit:
 *               p_err       Pointer to variable that will receive the return error code from this function :
 *
 *                               FTPc_ERR_NONE                   Transmission of file was successful.
+*                               FTPc_ERR_CMD_LEN                Command longer than control buffer.
 *                               FTPc_ERR_TX_CMD                 Sending Command failed.
 *                               FTPc_ERR_RX_CMD_RESP_FAIL       Receiving Command response failed.
 *                               FTPc_ERR_FILE_OPEN_FAIL         File opening faulted on FS.
@@ -1283,84 +1647,163 @@ CPU_BOOLEAN  FTPc_SendFile (FTPc_CONN    *p_conn,
                             FTPc_ERR     *p_err)
 {
 #if (FTPc_CFG_USE_FS == DEF_ENABLED)
+    CPU_BOOLEAN  rtn_code;
+
+
+    rtn_code = FTPc_SendFileSrc(p_conn,
+                                p_remote_file_name,
+                               &FTPc_FileSrcFS,
+                                p_local_file_name,
+                                append,
+                                p_err);
+
+    return (rtn_code);
+#else
+    return (DEF_FAIL);
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                          FTPc_SendFileSrc()
+*
+* Description : Send a file provided by a file source to an FTP server.
+*
+* Argument(s) : p_conn              Pointer to FTPc Connection object.
+*
+*               p_remote_file_name  Pointer to name of the file in FTP server.
+*
+*               p_src_api           Pointer to file source API (see Note #1).
+*
+*               p_local_file_name   Pointer to name of the file, passed to the file source.
+*
+*               append              if DEF_YES, existing file on FTP server will be appended with
+*                                       local file.  If file doesn't exist on FTP server, it will be
+*                                       created.
+*                                   if DEF_NO, existing file on FTP server will be overwritten.
+*                                       If file doesn't exist on FTP server, it will be created.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FTPc_ERR_NONE                   Transmission of file was successful.
+*                               FTPc_ERR_FAULT_NULL_PTR         Invalid file source API.
+*                               FTPc_ERR_CMD_LEN                Command longer than control buffer.
+*                               FTPc_ERR_TX_CMD                 Sending Command failed.
+*                               FTPc_ERR_RX_CMD_RESP_FAIL       Receiving Command response failed.
+*                               FTPc_ERR_FILE_OPEN_FAIL         File opening faulted on FS.
+*                               FTPc_ERR_FAULT                  File reading faulted.
+*                               FTPc_ERR_CONN_FAIL              Data connection failed.
+*
+* Return(s)   : DEF_FAIL        transmission failed.
+*               DEF_OK          transmission successful.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) See 'ftp-c.h  FTPc FILE SOURCE API DATA TYPE'.
+*
+*               (2) When the file source maps the file contents in memory, data is transmitted directly
+*                   from the mapping without being copied to the data buffer.
+*
+*               (3) In ASCII mode, file data is read into the upper half of the data buffer & converted
+*                   to network ASCII into the same buffer, since converting LF line endings to CRLF at
+*                   most doubles the size of the data (see FTPc_AsciiTxConv()).
+*
+*               (4) The file is opened before the STOR or APPE command is sent, so that a file that
+*                   cannot be read never creates or truncates the file on the FTP server. A read or
+*                   transmit error during the transfer aborts it (see FTPc_XferEnd() Note #3).
+*
+*               (5) The file source MAY return fewer octets than requested before the end of the file
+*                   (e.g. at a file system block or buffer boundary); the file is read until Rd()
+*                   returns no data.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  FTPc_SendFileSrc (      FTPc_CONN          *p_conn,
+                                     CPU_CHAR           *p_remote_file_name,
+                               const FTPc_FILE_SRC_API  *p_src_api,
+                                     CPU_CHAR           *p_local_file_name,
+                                     CPU_BOOLEAN         append,
+                                     FTPc_ERR           *p_err)
+{
     const  FTPc_CFG     *p_cfg;
            NET_SOCK_ID   sock_dtp_id;
            CPU_CHAR      data_buf[FTPc_DTP_NET_BUF_SIZE];
            CPU_CHAR      ctrl_buf[FTPc_CTRL_NET_BUF_SIZE];
            CPU_INT32U    ctrl_buf_size;
-           CPU_INT32U    buf_size;
            CPU_INT32U    reply_code;
            CPU_BOOLEAN   rtn_code;
+           CPU_BOOLEAN   xfer_open;
            CPU_INT32U    tx_pkt_cnt;
            void         *p_file;
+    const  CPU_CHAR     *p_map;
+           CPU_SIZE_T    map_len;
+           CPU_SIZE_T    map_ix;
+           CPU_CHAR     *p_rd_buf;
+           CPU_CHAR     *p_tx_buf;
+           CPU_SIZE_T    rd_len;
            CPU_SIZE_T    fs_len;
+           CPU_SIZE_T    tx_len;
+           CPU_SIZE_T    src_len;
            CPU_BOOLEAN   fs_err;
            NET_ERR       err;
 
 
-    p_cfg = FTPc_CfgPtr;
+    if ((p_src_api        == DEF_NULL) ||
+        (p_src_api->Open  == DEF_NULL) ||
+        (p_src_api->Rd    == DEF_NULL) ||
+        (p_src_api->Close == DEF_NULL)) {
+       *p_err = FTPc_ERR_FAULT_NULL_PTR;
+        return (DEF_FAIL);
+    }
+
+    p_cfg = p_conn->CfgPtr;
+
+    FTPc_STAT_RESET(p_conn);
+    FTPc_STAT_TS(p_conn, TS_Start);
+    FTPc_META_CACHE_INV(p_conn, p_remote_file_name);            /* Remote file is about to change.                      */
 
-    ctrl_buf_size = sizeof(ctrl_buf);
-                                                                /* Send TYPE command.                                   */
-    buf_size = Str_FmtPrint((char *)ctrl_buf, ctrl_buf_size, "%s %c\r\n", FTPc_Cmd[FTP_CMD_TYPE].CmdStr, FTP_TYPE_IMAGE);
-    rtn_code = FTPc_Tx(p_conn->SockID,
-                       ctrl_buf,
-                       buf_size,
-                       p_cfg->CtrlTxMaxTimout_ms,
-                       p_cfg->CtrlTxMaxRetry,
-                       p_cfg->CtrlTxMaxDly_ms,
-                      &err);
-    FTPc_TRACE_INFO(("FTPc TX: %s", ctrl_buf));
-    if (rtn_code == DEF_FAIL) {
-        *p_err    = FTPc_ERR_TX_CMD;
-         rtn_code = DEF_FAIL;
-         goto exit;
+    p_file = p_src_api->Open(p_local_file_name);                /* See Note #4.                                         */
+    if (p_file == (void *)0) {
+       *p_err = FTPc_ERR_FILE_OPEN_FAIL;
+        rtn_code = DEF_FAIL;
+        goto exit;
     }
 
-                                                                /* Receive status line.                                 */
-    reply_code = FTPc_WaitForStatus(p_conn, 0, 0, &err);
-    if (reply_code != FTP_REPLY_CODE_OKAY) {
-        *p_err    = FTPc_ERR_RX_CMD_RESP_FAIL;
-         rtn_code = DEF_FAIL;
-         goto exit;
+    p_map   = DEF_NULL;
+    map_len = 0u;
+    map_ix  = 0u;
+    if (p_src_api->Map != DEF_NULL) {                           /* See Note #2.                                         */
+        p_map = (const CPU_CHAR *)p_src_api->Map(p_file, &map_len);
+    }
+
+    p_conn->AsciiCR = DEF_NO;
+    ctrl_buf_size   = sizeof(ctrl_buf);
+                                                                /* Set data type.                                       */
+    rtn_code = FTPc_TypeReq(p_conn, p_conn->Type, ctrl_buf, ctrl_buf_size, p_err);
+    if (rtn_code == DEF_FAIL) {
+        goto exit_close_file;
     }
 
     sock_dtp_id = FTPc_Conn(p_conn, ctrl_buf, ctrl_buf_size, p_err);
     if (sock_dtp_id == NET_SOCK_ID_NONE) {
         rtn_code = DEF_FAIL;
-        goto exit;
+        goto exit_close_file;
     }
 
+    xfer_open = DEF_NO;
 
     if (append == DEF_YES) {
                                                                 /* Send APPE command.                                   */
-        buf_size = Str_FmtPrint((char *)ctrl_buf, ctrl_buf_size, "%s %s\r\n", FTPc_Cmd[FTP_CMD_APPE].CmdStr, p_remote_file_name);
-        rtn_code = FTPc_Tx(p_conn->SockID,
-                           ctrl_buf,
-                           buf_size,
-                           p_cfg->CtrlTxMaxTimout_ms,
-                           p_cfg->CtrlTxMaxRetry,
-                           p_cfg->CtrlTxMaxDly_ms,
-                          &err);
-        FTPc_TRACE_INFO(("FTPc TX: %s", ctrl_buf));
+        rtn_code = FTPc_CmdTx(p_conn, FTP_CMD_APPE, p_remote_file_name, ctrl_buf, ctrl_buf_size, p_err);
         if (rtn_code == DEF_FAIL) {
-           *p_err = FTPc_ERR_TX_CMD;
             rtn_code = DEF_FAIL;
             goto exit_close_dtp_sock;
         }
     } else {
                                                                 /* Send STOR command.                                   */
-        buf_size = Str_FmtPrint((char *)ctrl_buf, ctrl_buf_size, "%s %s\r\n", FTPc_Cmd[FTP_CMD_STOR].CmdStr, p_remote_file_name);
-        rtn_code = FTPc_Tx(p_conn->SockID,
-                           ctrl_buf,
-                           buf_size,
-                           p_cfg->CtrlTxMaxTimout_ms,
-                           p_cfg->CtrlTxMaxRetry,
-                           p_cfg->CtrlTxMaxDly_ms,
-                           &err);
-        FTPc_TRACE_INFO(("FTPc TX: %s", ctrl_buf));
+        rtn_code = FTPc_CmdTx(p_conn, FTP_CMD_STOR, p_remote_file_name, ctrl_buf, ctrl_buf_size, p_err);
         if (rtn_code == DEF_FAIL) {
-           *p_err = FTPc_ERR_TX_CMD;
             rtn_code = DEF_FAIL;
             goto exit_close_dtp_sock;
         }
@@ -1372,853 +1815,4450 @@ CPU_BOOLEAN  FTPc_SendFile (FTPc_CONN    *p_conn,
         rtn_code = DEF_FAIL;
         goto exit_close_dtp_sock;
     }
-
-    p_file = NetFS_FileOpen(p_local_file_name,
-                            NET_FS_FILE_MODE_OPEN,
-                            NET_FS_FILE_ACCESS_RD);
-    if (p_file == (void *)0) {
-       *p_err = FTPc_ERR_FILE_OPEN_FAIL;
-        rtn_code = DEF_FAIL;
-        goto exit_close_dtp_sock;
-    }
+    FTPc_STAT_TS(p_conn, TS_XferCmd);
+    xfer_open = DEF_YES;
 
     tx_pkt_cnt = 0;
 
-    NetSock_CfgTimeoutRxQ_Set(sock_dtp_id, p_cfg->DTP_TxMaxTimout_ms, &err);
+    NetSock_CfgTimeoutTxQ_Set(sock_dtp_id, p_cfg->DTP_TxMaxTimout_ms, &err);
+
+    p_rd_buf = data_buf;
+    rd_len   = sizeof(data_buf);
+    if (p_conn->Type == FTP_TYPE_ASCII) {                       /* See Note #3.                                         */
+        rd_len   = sizeof(data_buf) / 2u;
+        p_rd_buf = data_buf + rd_len;
+    }
 
     while (DEF_TRUE) {
-        fs_err = NetFS_FileRd(p_file,
-                              data_buf,
-                              sizeof(data_buf),
-                             &fs_len);
-        if (fs_len == 0) {
-            if (fs_err != DEF_OK) {
-                FTPc_TRACE_DBG(("FTPc NetFS_FileRd() failed, line #%u.\n", (unsigned int)__LINE__));
-            }
+        if (p_map != DEF_NULL) {                                /* Get next chunk from file mapping ...                 */
+            fs_err   = DEF_OK;
+            fs_len   = DEF_MIN(map_len - map_ix, rd_len);
+            p_rd_buf = (CPU_CHAR *)&p_map[map_ix];
+            map_ix  += fs_len;
+        } else {                                                /* ... or rd it from file.                              */
+            fs_err   = p_src_api->Rd(p_file,
+                                     p_rd_buf,
+                                     rd_len,
+                                    &fs_len);
+        }
+        if (fs_err != DEF_OK) {
+            FTPc_TRACE_DBG(("FTPc file source Rd() failed, line #%u.\n", (unsigned int)__LINE__));
+           *p_err = FTPc_ERR_FAULT;                             /* See Note #4.                                         */
+            break;
+        }
+        if (fs_len == 0) {                                      /* See Note #5.                                         */
             break;
         }
 
-        FTPc_TRACE_DBG(("FTPc TX DATA #%03u... ", tx_pkt_cnt));
-        rtn_code = FTPc_Tx(sock_dtp_id,
-                           data_buf,
-                           fs_len,
+        p_tx_buf = p_rd_buf;
+        tx_len   = fs_len;
+        if (p_conn->Type == FTP_TYPE_ASCII) {
+            p_tx_buf = data_buf;
+            tx_len   = FTPc_AsciiTxConv(p_conn, p_rd_buf, fs_len, data_buf, sizeof(data_buf), &src_len);
+        }
+
+        rtn_code = FTPc_Tx(p_conn,
+                           sock_dtp_id,
+                           p_tx_buf,
+                           tx_len,
                            0,
                            p_cfg->DTP_TxMaxRetry,
                            p_cfg->DTP_TxMaxDly_ms,
                            &err);
         if (rtn_code == DEF_FAIL) {
             FTPc_TRACE_DBG(("FTPc FTPc_Tx() failed: error #%u, line #%u.\n", (unsigned int)err, (unsigned int)__LINE__));
+            FTPc_TRACE_EVT(FTPc_TRACE_EVT_DTP_TX_ERR, err, tx_pkt_cnt);
+           *p_err = FTPc_ERR_CONN_FAIL;                         /* See Note #4.                                         */
             break;
         }
 
-        FTPc_TRACE_DBG(("\n"));
-        if (fs_len != sizeof(data_buf)) {
-            break;
-        }
+        FTPc_TRACE_EVT(FTPc_TRACE_EVT_DTP_TX, tx_pkt_cnt, tx_len);
+        FTPc_STAT_TS_FIRST(p_conn, TS_FirstByte);
+        FTPc_STAT_ADD(p_conn, TxBytes, tx_len);
+        FTPc_HIST_XFER_ADD(p_conn, tx_len);
+        FTPc_DTP_THROTTLE(p_conn, tx_len);
+        FTPc_SCHED_YIELD(p_conn);
         tx_pkt_cnt++;
     }
-
-    NetFS_FileClose(p_file);
-
+    FTPc_STAT_TS(p_conn, TS_LastByte);
 
 exit_close_dtp_sock:
-                                                                /* Close socket.                                        */
-    NetSock_Close(sock_dtp_id, &err);
-    FTPc_TRACE_INFO(("FTPc CLOSE DTP socket.\n"));
-
-    if (*p_err == FTPc_ERR_NONE) {
-                                                                /* Receive status line.                                 */
-        reply_code = FTPc_WaitForStatus(p_conn, 0, 0, &err);
-        if (reply_code != FTP_REPLY_CODE_CLOSINGSUCCESS) {
-            *p_err = FTPc_ERR_RX_CMD_RESP_FAIL;
-             rtn_code = DEF_FAIL;
-             goto exit;
-         }
-
-         rtn_code = DEF_OK;
-
-     } else {
-         goto exit;
-     }
-
+    rtn_code = FTPc_XferEnd(p_conn, sock_dtp_id, xfer_open, ctrl_buf, ctrl_buf_size, p_err);
 
-   *p_err = FTPc_ERR_NONE;
+exit_close_file:
+    p_src_api->Close(p_file);
 
 exit:
     return (rtn_code);
-#else
-    return (DEF_FAIL);
-#endif
 }
 
 
 /*
 *********************************************************************************************************
-*********************************************************************************************************
-*                                           LOCAL FUNCTIONS
-*********************************************************************************************************
-*********************************************************************************************************
-*/
-
-
-/*
-*********************************************************************************************************
-*                                         FTPc_WaitForStatus()
+*                                         FTPc_SendFileBatch()
 *
-* Description : Receive FTP server reply after a request and analyze it to find the server status reply.
+* Description : Send a batch of files to an FTP server over the same control connection.
 *
 * Argument(s) : p_conn          Pointer to FTPc Connection object.
 *
-*               p_ctrl_data     Pointer to  buffer  that will receive control reply data.
+*               p_file_tbl      Pointer to table of local & remote file names, in transfer order.
 *
-*               ctrl_data_len   Size of the buffer  that will receive control reply data.
+*               file_nbr        Number of files in table.
 *
-*               p_err           Pointer to variable that will receive the return error code from NetSock_RxData().
+*               p_src_api       Pointer to file source API of the local files (see FTPc_SendFileSrc()),
+*                               or DEF_NULL to read the files from the file system.
 *
-* Return(s)   : FTP server status code   if no error;
-*               0                        otherwise.
+*               p_result_fnct   Pointer to function called with the result of each file transfer, or
+*                               DEF_NULL (see Note #2).
 *
-* Caller(s)   : FTPc_Open(),
-*               FTPc_Close(),
-*               FTPc_RecvBuf(),
-*               FTPc_SendBuf(),
-*               FTPc_RecvFile(),
-*               FTPc_SendFile().
+*               p_result_arg    Pointer to argument passed to the result function.
 *
-* Note(s)     : (1) Even though the server reply code can be retrieved from the first 3 octets in the
-*                   received message, it is mandatory that the whole response be taken from the socket
-*                   receive queue in order to make sure no "left over" messages will be present at the
-*                   socket at a later call to this function.
-*                   
-*                   (a) However, section 5.4 of RFC 959 titled "SEQUENCING OF COMMANDS AND REPLIES" 
-*                       states the following in its second paragraph:
+*               p_err       Pointer to variable that will receive the return error code from this function :
 *
-*                      "Certain commands require a second reply for which the user should also wait.
-*                       These replies may, for example, report on the progress or completion of file
-*                       transfer or the closing of the data connection. They are secondary replies to
-*                       file transfer commands."
+*                               FTPc_ERR_NONE                   All files sent successfully.
+*                               FTPc_ERR_FAULT_NULL_PTR         Invalid file table or file source API.
+*                               Error code of the last failed file transfer, otherwise.
+*
+* Return(s)   : DEF_FAIL        one or more file transfers failed.
+*               DEF_OK          all files sent successfully.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) The setup of successive transfers is overlapped as allowed by the protocol :
 *
-*                       To this end, we prepend the "/" character to p_conn->Buf to let this function know in 
-*                       a future call that the non-zero data in p_conn->Buf is part of a multi-response reply
-*                       whose response code is yet to be decoded.
+*                   (a) Batch mode is enabled up to the last file of the batch, so that the passive port
+*                       of each transfer is requested while the completion reply of the previous one is
+*                       received (see FTPc_BatchModeSet()).
+*                   (b) The TYPE command is only sent for the first file (see FTPc_TypeReq()).
 *
-*               (2) As data is consumed from the socket receive queue, in a situation where the server's 
-*                   welcome message extends beyond the size of the buffer once FTPc_RxReply() is called 
-*                   to retrieve more data from the socket receive queue, the reply code is no longer  
-*                   guaranteed to be the first three octets in the receive message. Thus the search string
-*                   must be advanced until the next instance of the reply code. This applies only if the
-*                   reply message is already known to be multiline.
+*                   Each file still waits for its own completion reply, since the server only confirms
+*                   that a file was stored with this reply.
+*
+*               (2) The result function is called after each file transfer with the index of the file
+*                   in the table & its error code. A failed file transfer is aborted & the control
+*                   connection resynchronized (see FTPc_XferEnd() Note #3), so that the next file is
+*                   still sent. The batch is aborted if a command cannot be sent on the control
+*                   connection or if the control connection is out of sync (see FTPc_WaitForStatus()
+*                   Note #4); the remaining files are then not reported.
 *********************************************************************************************************
 */
 
-static  CPU_INT32U  FTPc_WaitForStatus (FTPc_CONN   *p_conn,
-                                        CPU_CHAR    *p_ctrl_data,
-                                        CPU_INT16U   ctrl_data_len,
-                                        NET_ERR     *p_err)
+CPU_BOOLEAN  FTPc_SendFileBatch (      FTPc_CONN             *p_conn,
+                                 const FTPc_FILE_PAIR        *p_file_tbl,
+                                       CPU_SIZE_T             file_nbr,
+                                 const FTPc_FILE_SRC_API     *p_src_api,
+                                       FTPc_XFER_RESULT_FNCT  p_result_fnct,
+                                       void                  *p_result_arg,
+                                       FTPc_ERR              *p_err)
 {
-    const  FTPc_CFG     *p_cfg;
-           CPU_CHAR     *p_buf;
-           CPU_CHAR     *p_str_multiline;
-           CPU_CHAR     *p_search_str;
-           CPU_CHAR     *trunc_str;
-           CPU_CHAR      end_of_cmd[FTP_EOL_DELIMITER_LEN + FTP_REPLY_CODE_LEN + 2];
-           CPU_CHAR      multiline_token[FTP_EOL_DELIMITER_LEN + FTP_REPLY_CODE_LEN + 2];
-           CPU_INT16U    reply_code;
-           CPU_INT16U    rx_reply_ctr;
-           CPU_INT32U    len;
-           CPU_INT32U    buf_len;
-           CPU_INT32S    rx_reply_tot_len;
-           CPU_INT32S    rx_reply_pkt_len;
-           CPU_BOOLEAN   find_eof;
-           CPU_BOOLEAN   parse_done;
-           CPU_BOOLEAN   is_msg_truncated;
-           CPU_BOOLEAN   truncated_parsed;
-           CPU_BOOLEAN   token_found;
-           CPU_BOOLEAN   rx_reply;
-           CPU_INT16S    cmp;
-
-
-    Mem_Clr(end_of_cmd, sizeof(end_of_cmd));
-
-    p_cfg                                                       =  FTPc_CfgPtr;
-    end_of_cmd[0u]                                              =  FTP_ASCII_CR;
-    end_of_cmd[1u]                                              =  FTP_ASCII_LF;
-    end_of_cmd[FTP_EOL_DELIMITER_LEN + FTP_REPLY_CODE_LEN]      =  FTP_ASCII_SPACE;
-    end_of_cmd[FTP_EOL_DELIMITER_LEN + FTP_REPLY_CODE_LEN + 1u] = (CPU_CHAR)'\0';
-    reply_code                                                  =  0u;
-    rx_reply_tot_len                                            =  0;
-    rx_reply_pkt_len                                            =  0;
-    find_eof                                                    =  DEF_NO;
-    parse_done                                                  =  DEF_NO;
-    rx_reply                                                    =  DEF_NO;
-    p_buf                                                       = (CPU_CHAR *)&p_conn->Buf[0u];
-    buf_len                                                     =  sizeof(p_conn->Buf);
-    is_msg_truncated                                            =  DEF_FALSE;
-    truncated_parsed                                            =  DEF_FALSE;
-    token_found                                                 =  DEF_FALSE;
-    rx_reply_ctr                                                =  0u;
+    CPU_SIZE_T   file_ix;
+    CPU_BOOLEAN  batch_en;
+    CPU_BOOLEAN  rtn_code;
+    FTPc_ERR     err;
 
-    
-    if (*p_buf == (CPU_CHAR)'\0') {
-        rx_reply = DEF_YES;
+
+    if (p_src_api == DEF_NULL) {
+#if (FTPc_CFG_USE_FS == DEF_ENABLED)
+        p_src_api = &FTPc_FileSrcFS;
+#else
+       *p_err = FTPc_ERR_FAULT_NULL_PTR;
+        return (DEF_FAIL);
+#endif
     }
 
-    NetSock_CfgTimeoutRxQ_Set(p_conn->SockID, p_cfg->CtrlRxMaxTimout_ms, p_err);
-    while (parse_done == DEF_NO) {
-        if (rx_reply == DEF_YES) {
-            if (rx_reply_tot_len < p_cfg->CtrlRxMaxReplyLength) {
-                KAL_Dly(5u);                                    /* Allow Rx Task to place new data onto Large Rx buffer.*/
-                p_buf            = (CPU_CHAR *)&p_conn->Buf[0u];
-                rx_reply_pkt_len = FTPc_RxReply(p_conn->SockID,
-                                                p_buf,
-                                                buf_len - 1u,
-                                                p_err);
-            } else {
-                NetSock_CfgRxQ_Size(p_conn->SockID, 0u, p_err);
-               *p_err = NET_SOCK_ERR_RX_Q_CLOSED;
-            }
-            switch (*p_err) {
-                case NET_SOCK_ERR_NONE:
-                case NET_ERR_RX:
-                case NET_ERR_INIT_INCOMPLETE:
-                case NET_SOCK_ERR_RX_Q_EMPTY:
-                case NET_ERR_FAULT_LOCK_ACQUIRE:
-                     rx_reply_ctr++;
-                     break;
+    if ((p_file_tbl == DEF_NULL) &&
+        (file_nbr   >  0u)) {
+       *p_err = FTPc_ERR_FAULT_NULL_PTR;
+        return (DEF_FAIL);
+    }
 
+    batch_en = p_conn->BatchEn;
+    FTPc_BatchModeSet(p_conn, DEF_ENABLED);                     /* See Note #1a.                                        */
 
-                case NET_ERR_FAULT_NULL_PTR:
-                case NET_SOCK_ERR_INVALID_DATA_SIZE:
-                case NET_SOCK_ERR_CLOSED:
-                case NET_SOCK_ERR_RX_Q_CLOSED:
-                case NET_SOCK_ERR_NOT_USED:
-                case NET_SOCK_ERR_INVALID_TYPE:
-                case NET_SOCK_ERR_INVALID_SOCK:
-                case NET_SOCK_ERR_INVALID_FLAG:
-                case NET_SOCK_ERR_INVALID_ADDR_LEN:
-                case NET_SOCK_ERR_INVALID_OP:
-                case NET_SOCK_ERR_INVALID_FAMILY:
-                case NET_SOCK_ERR_INVALID_PROTOCOL:
-                case NET_SOCK_ERR_INVALID_STATE:
-                case NET_SOCK_ERR_CONN_FAIL:
-                case NET_SOCK_ERR_FAULT:
-                case NET_CONN_ERR_NOT_USED:
-                case NET_CONN_ERR_INVALID_CONN:
-                case NET_CONN_ERR_INVALID_ADDR_LEN:
-                case NET_CONN_ERR_ADDR_NOT_USED:
-                default:
-                     return (0u);
-            }
+   *p_err = FTPc_ERR_NONE;
+    for (file_ix = 0u; file_ix < file_nbr; file_ix++) {
+        if ((file_ix + 1u) == file_nbr) {                       /* No next xfer after last file (see Note #1a).         */
+            p_conn->BatchEn = batch_en;
         }
 
-        if ((rx_reply         == DEF_NO) ||
-            (rx_reply_pkt_len  > 0     )) {
-
-            if (rx_reply == DEF_YES) {
-                rx_reply_tot_len        +=  rx_reply_pkt_len;
-                p_buf[rx_reply_pkt_len]  = (CPU_CHAR)'\0';      /* Append termination char.                             */
-                FTPc_TRACE_INFO(("%s", p_buf + rx_reply_pkt_len));
-            }
-                                                                /* Flag msg as truncated if it's taken more than one... */
-                                                                /* ...attempt to parse the entire reply.                */
-            is_msg_truncated = (*(p_buf + rx_reply_pkt_len - 1u) != FTP_ASCII_LF && !token_found);
-            p_search_str     = p_buf;
-
-            while ((rx_reply_ctr  > 0u) && 
-                   (reply_code   == 0u)) {
-                p_str_multiline = Str_Char_N(p_buf,             /* Check if it's a multiline reply.                     */
-                                             rx_reply_pkt_len,
-                                             FTP_REPLY_CODE_MULTI_LINE_INDICATOR);
-
-                if ((p_str_multiline           != (CPU_CHAR *)DEF_NULL) && 
-                    ((p_str_multiline - p_buf) != FTP_REPLY_CODE_LEN  )) {
-                    reply_code = (CPU_INT16U)Str_ParseNbr_Int32U(p_str_multiline - FTP_REPLY_CODE_LEN, 0, 10);
-                    if (reply_code == 0u) {
-                        p_buf           = p_str_multiline + 1u; /* Not multiline if '-' is found & is not preceded...   */
-                        p_str_multiline = (CPU_CHAR *)DEF_NULL; /*  ...by the reply code.                               */
-                    }
-                } else {
-                    find_eof = DEF_TRUE;
-                    break;
-                }
-            }
-
-            if (p_str_multiline == DEF_NULL) {
-                p_buf = p_search_str;
-            }
-                                                                /* Build end-of-command token to search.                */
-            if (end_of_cmd[FTP_EOL_DELIMITER_LEN] == (CPU_CHAR)'\0') {
-                if (rx_reply == DEF_TRUE) {
-                    Str_Copy_N((CPU_CHAR *)end_of_cmd + FTP_EOL_DELIMITER_LEN,
-                                           p_buf,
-                               (CPU_SIZE_T)FTP_REPLY_CODE_LEN);
-                }
-            }
-
-            if (rx_reply_ctr == 0u) {                           /* -  CASE I: NOTHING HAS BEEN CONSUMED FROM RX Q YET - */
-                cmp = Str_Cmp_N(p_buf,                          /* First check if buf contains data from a prev. reply. */
-                                FTP_MULTI_REPLY_DELIM, 
-                                1u);
+        err      = FTPc_ERR_NONE;
+        rtn_code = FTPc_SendFileSrc(p_conn,
+                                    p_file_tbl[file_ix].RemoteNamePtr,
+                                    p_src_api,
+                                    p_file_tbl[file_ix].LocalNamePtr,
+                                    DEF_NO,
+                                   &err);
+        if (rtn_code != DEF_OK) {
+           *p_err = err;
+        }
 
-                rx_reply = (cmp != 0);                          /* If it doesn't, consume data & place it in rx buffer. */
-                if (rx_reply) {
-                    continue;
-                }
+        if (p_result_fnct != DEF_NULL) {                        /* See Note #2.                                         */
+            p_result_fnct(file_ix, err, p_result_arg);
+        }
 
-                p_buf++;                                        /* If it does, advance pointer & find "\r\n" EOF token. */
-                find_eof = DEF_YES;
-            } else if (rx_reply_ctr == 1u) {                    /* - CASE II: RESPONSE LENGTH SPANS ONE BUFFER SO FAR - */
-                if (*p_str_multiline == FTP_REPLY_CODE_MULTI_LINE_INDICATOR) {
-                                                                /* Check if end-of-command token came in the same pkt.  */
-                    p_search_str = Str_Str_N(p_buf, end_of_cmd, buf_len);
-                    token_found  = (p_search_str != (void *)0);
-
-                    if ((token_found != DEF_TRUE) || (token_found && is_msg_truncated)) {
-                        len = sizeof(multiline_token);
-                        Str_Copy_N( multiline_token,            /* Save last seven octets of rx buffer in case the ...  */
-                                   &p_buf[FTPc_CTRL_NET_BUF_SIZE - len],
-                                    len);                       /* ... end-of-command token itself was truncated.       */
-
-                        Mem_Clr(&p_conn->Buf[0u], buf_len);     /* Clear entire buffer; end-of-cmd token was not found. */
-                        is_msg_truncated = DEF_TRUE;        
-                    } else {
-                        find_eof      = DEF_YES;
-                        p_search_str += 2u;                     /* See Note #2.                                         */
-                    }
-                } else {
-                    len      = rx_reply_pkt_len;
-                    find_eof = DEF_YES;
-                }
-            } else {                                            /* - CASE III: RESPONSE LENGTH SPANS MULTIPLE BUFFERS - */
-                if (token_found && !find_eof) {
-                    rx_reply = DEF_NO;
-                    find_eof = DEF_YES;
-                    continue;
-                }
-                                                                /* Handle case where end-of-cmd token might be truncated*/
-                if ((*p_str_multiline != FTP_REPLY_CODE_MULTI_LINE_INDICATOR) && 
-                    ( rx_reply_pkt_len > 1u)) {
-                    len       = sizeof(multiline_token);        /* No multiline char found, check if end of cmd token...*/
-                                                                /*...was truncated in between buffer reads.             */
-                    trunc_str = Str_Char_N(multiline_token,     /* Find '\r' in the last seven octets of old buffer ... */
-                                           len,                 /* ...and if found, examine how truncated the token was.*/
-                                           FTP_ASCII_CR);
-                    len       = sizeof(multiline_token) - Str_Len(trunc_str);
-                                                                /* Move partial token to the beginning of the array ... */
-                    Str_Copy(multiline_token, trunc_str);       /* ... and clear the rest of the array.                 */
-                    Mem_Clr((multiline_token + sizeof(multiline_token) - len), len);
-                    len = Str_Len(multiline_token);
-
-                    if (len != 0u) {                            /* Was token partially contained in prev. buffer read?  */
-                        Str_Copy_N(multiline_token + len,       /* Reconstruct token for comparison.                    */
-                                   p_buf,
-                                   (sizeof(multiline_token) - len - 1u));
-
-                        len = Str_Len(end_of_cmd);
-                        cmp = Str_Cmp_N(multiline_token,        /* Does reconstructed token match end-of-cmd token?     */
-                                        end_of_cmd, 
-                                        len); 
-                        if (cmp == 0) { 
-                            truncated_parsed = DEF_TRUE;        /* Indicates truncated token was successfully parsed.   */
-                            rx_reply         = DEF_NO;
-                            is_msg_truncated = DEF_NO;
-                            token_found      = DEF_YES;
-                        }
-                    }
-                }
-            }
-                                                                /* -     SEARCH FOR TERMINATING "\r\n" CHARACTERS     - */
-                                                                /* Rx pkt as long as end of file is not rx'd.           */
-            if (find_eof == DEF_YES) {
-                if (rx_reply_ctr <= 1u) {
-                    p_search_str  = Str_Char_N(p_search_str, len, FTP_ASCII_CR);
-                    if ( (p_search_str       != (void *)0)     &&
-                       (*(p_search_str + 1u) ==  FTP_ASCII_LF)) {
-                        parse_done    = DEF_YES;
-                                                                /* Chk reply code.                                      */
-                        reply_code    = Str_ParseNbr_Int32U(p_buf, 0, 10);  
-                        p_search_str += 2u;
-
-                        if (*p_search_str != (CPU_CHAR)'\0') {  /* Check if rest of buf has reply data (See Note #1a).  */
-                            len = Str_Len(p_search_str) + 1u;
-                                                                /* Prepend "/" delimiter at the beginning of buffer.    */
-                            Str_Copy_N(p_buf, FTP_MULTI_REPLY_DELIM, 1u);
-                            Str_Copy_N(p_buf + 1u, p_search_str, len);
-
-                            if (p_ctrl_data != (CPU_CHAR *)0) {
-                                if (len > ctrl_data_len) {
-                                    len = ctrl_data_len;
-                                }
-                                Str_Copy_N(p_ctrl_data, p_buf, len);
-                            }
-                        } else {
-                            if (p_ctrl_data != (CPU_CHAR *)0) {
-                                Str_Copy_N(p_ctrl_data, p_buf, ctrl_data_len);
-                            }
-                            (rx_reply_tot_len > 0)                         ?
-                            (Mem_Clr(&p_conn->Buf[0u], rx_reply_pkt_len))  :
-                            (Mem_Clr(&p_conn->Buf[0u], buf_len));  
-                        }
-                    } else if (rx_reply == DEF_NO) {
-                        rx_reply         = DEF_YES;
-                    }
-                } else {
-                    if ((token_found      == DEF_TRUE) || 
-                        (truncated_parsed == DEF_TRUE)) {
-                        len = Str_Len(multiline_token);
-                                                                /* Check whether terminating "\r\n" itself is split ... */
-                                                                /* ... between buffer reads if new buffer contains  ... */
-                                                                /* ... only one byte.                                   */
-                        if (( rx_reply_pkt_len         == 1u)            &&
-                            (*p_buf                    == FTP_ASCII_LF)  &&
-                            ( multiline_token[len - 1] == FTP_ASCII_CR))  {
-                            p_search_str     = end_of_cmd;      /* Token was found, just point to end-of-command string.*/
-                            p_buf            = p_search_str;
-                            truncated_parsed = DEF_TRUE;
-                        } else { 
-                            p_search_str = p_buf;
-                            len          = token_found ? Str_Len(p_search_str) : rx_reply_pkt_len;
-                        }
-                    } else {
-                        len = buf_len - (p_search_str - p_buf);
-                    }
-                                                                /* Search for last instance of '\r' in last rx'd packet */
-                    while (DEF_ON) {
-                        trunc_str     = p_search_str;
-                        p_search_str  = Str_Char_N(p_search_str, len, FTP_ASCII_CR);
-
-                        if (truncated_parsed == DEF_TRUE || p_search_str == (void *)0) {
-                            break;
-                        } else if (p_search_str < (CPU_CHAR *)(p_conn->Buf + rx_reply_pkt_len - FTP_EOL_DELIMITER_LEN)) {
-                            trunc_str    = p_search_str;
-                            trunc_str   += FTP_EOL_DELIMITER_LEN;
-                            p_search_str = trunc_str;
-                        } else {
-                            p_buf = trunc_str;
-                            break;
-                        }
-                    }
-                    if ( (p_search_str       != (void *)0)     &&
-                       (*(p_search_str + 1u) ==  FTP_ASCII_LF)) {
-                        parse_done    = DEF_YES;
-                                                                /* Chk reply code.                                      */
-                        reply_code    = (token_found || truncated_parsed)        ?
-                                        (Str_ParseNbr_Int32U(end_of_cmd, 0, 10)) :
-                                        (Str_ParseNbr_Int32U(p_buf,      0, 10));
-                        p_search_str += 2u;
-
-                        if (*p_search_str != (CPU_CHAR)'\0') {
-                            len = buf_len - (p_search_str - p_buf);
-                            Str_Copy_N(p_buf, p_search_str, len);
-                   
-                            if (p_ctrl_data != (CPU_CHAR *)0) {
-                                if (len > ctrl_data_len) {
-                                    len = ctrl_data_len;
-                                }
-                                Str_Copy_N(p_ctrl_data, p_buf, len);
-                            }
-                        } else {
-                            if (p_ctrl_data != (CPU_CHAR *)0) {
-                                Str_Copy_N(p_ctrl_data, p_buf, ctrl_data_len);
-                            } 
-                        }
-                        Mem_Clr(&p_conn->Buf[0u], (rx_reply_pkt_len));
-                    } else if (rx_reply == DEF_NO) {
-                        rx_reply = DEF_YES;
-                    }
-                }
-            }
-        } else if (rx_reply_pkt_len < 0) {
-            return (0u);
+        if ((err              == FTPc_ERR_TX_CMD) ||            /* See Note #2.                                         */
+            (p_conn->CtrlFail == DEF_YES        )) {
+            break;
         }
     }
 
-    NetSock_CfgTimeoutRxQ_Set(p_conn->SockID, NET_TMR_TIME_INFINITE, p_err);
+    FTPc_BatchModeSet(p_conn, batch_en);
 
-    return (reply_code);
+    rtn_code = (*p_err == FTPc_ERR_NONE) ? DEF_OK : DEF_FAIL;
+
+    return (rtn_code);
 }
 
 
 /*
 *********************************************************************************************************
-*                                             FTPc_RxReply()
+*                                          FTPc_RecvBlkDev()
 *
-* Description : Receive reply data.
+* Description : Receive a file from an FTP server directly to a block device, such as a raw flash partition.
 *
-* Argument(s) : sock_id     TCP socket ID.
+* Argument(s) : p_conn              Pointer to FTPc Connection object.
 *
-*               p_data      Pointer to  buffer  that will receive data.
+*               p_remote_file_name  Pointer to name of the file in FTP server.
 *
-*               data_len    Size of the buffer  that will receive data.
+*               p_dev               Pointer to block device (see Note #1).
 *
-*               p_err       Pointer to variable that will receive the return error code from NetSock_RxData().
+*               p_file_size         Pointer to variable that will receive the number of octets received.
 *
-* Return(s)   : Number of positive data octets received, if NO errors;
-*               0                                        otherwise.
+*               p_err       Pointer to variable that will receive the return error code from this function :
 *
-* Caller(s)   : FTPc_WaitForStatus().
+*                               FTPc_ERR_NONE                   Reception of file was successful.
+*                               FTPc_ERR_FAULT_NULL_PTR         Invalid block device API or buffer.
+*                               FTPc_ERR_FAULT                  Invalid block device geometry, or
+*                                                                   reception faulted.
+*                               FTPc_ERR_CMD_LEN                Command longer than control buffer.
+*                               FTPc_ERR_TX_CMD                 Sending Command failed.
+*                               FTPc_ERR_RX_CMD_RESP_FAIL       Receiving Command response failed.
+*                               FTPc_ERR_FILE_NOT_FOUND         File of server not found.
+*                               FTPc_ERR_FILE_BUF_LEN           File larger than the block device.
+*                               FTPc_ERR_BLK_DEV_ERASE          Block device erase failed.
+*                               FTPc_ERR_BLK_DEV_WR             Block device write failed.
+*                               FTPc_ERR_BLK_DEV_VERIFY         Block device verification failed.
+*                               FTPc_ERR_RX_TIMEOUT             Data connection stalled.
+*                               FTPc_ERR_CONN_FAIL              Data connection failed.
 *
-* Note(s)     : None.
+* Return(s)   : DEF_FAIL        reception failed.
+*               DEF_OK          reception successful.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) See 'ftp-c.h  FTPc BLOCK DEVICE DATA TYPE'.
+*
+*               (2) The file is always transferred in IMAGE type, regardless of FTPc_TypeSet().
+*
+*               (3) Data is received directly into the block buffer, which is written to the device each
+*                   time it is full. The device's RAM requirement is therefore limited to a single block.
+*
+*               (4) The last block is padded with FTPc_BLK_DEV_PAD_VAL, the erased value of NOR flash.
 *********************************************************************************************************
 */
 
-static  CPU_INT32S  FTPc_RxReply (CPU_INT32S   sock_id,
-                                  CPU_CHAR    *p_data,
-                                  CPU_INT16U   data_len,
-                                  NET_ERR     *p_err)
+CPU_BOOLEAN  FTPc_RecvBlkDev (FTPc_CONN     *p_conn,
+                              CPU_CHAR      *p_remote_file_name,
+                              FTPc_BLK_DEV  *p_dev,
+                              CPU_INT32U    *p_file_size,
+                              FTPc_ERR      *p_err)
 {
-    const  FTPc_CFG     *p_cfg;
-           CPU_INT32S    pkt_size;
-           CPU_BOOLEAN   rx_done;
+    NET_SOCK_ID   sock_dtp_id;
+    CPU_CHAR      ctrl_buf[FTPc_CTRL_NET_BUF_SIZE];
+    CPU_INT32U    ctrl_buf_size;
+    CPU_INT32U    reply_code;
+    CPU_BOOLEAN   rtn_code;
+    CPU_BOOLEAN   xfer_open;
+    CPU_INT32U    rx_pkt_cnt;
+    CPU_INT32S    rx_len;
+    CPU_INT32U    addr;
+    CPU_INT32U    blk_len;
+    NET_ERR       err;
+
+
+   *p_file_size = 0u;
+
+    if ((p_dev                 == DEF_NULL) ||
+        (p_dev->ApiPtr         == DEF_NULL) ||
+        (p_dev->ApiPtr->Erase  == DEF_NULL) ||
+        (p_dev->ApiPtr->Wr     == DEF_NULL) ||
+        (p_dev->BufPtr         == DEF_NULL)) {
+       *p_err = FTPc_ERR_FAULT_NULL_PTR;
+        return (DEF_FAIL);
+    }
 
+    if ((p_dev->BlkSize                   == 0u) ||
+        (p_dev->SecSize                   == 0u) ||
+        (p_dev->BlkSize                    > DEF_INT_16U_MAX_VAL) ||
+        ((p_dev->SecSize % p_dev->BlkSize) != 0u) ||
+        ((p_dev->Size    % p_dev->SecSize) != 0u)) {
+       *p_err = FTPc_ERR_FAULT;
+        return (DEF_FAIL);
+    }
 
-    p_cfg = FTPc_CfgPtr;
+    if (p_dev->Size == 0u) {                                    /* Chk dev size before RETR is sent.                    */
+       *p_err = FTPc_ERR_FILE_BUF_LEN;
+        return (DEF_FAIL);
+    }
 
-    pkt_size = 0;
-    rx_done  = DEF_NO;
+    FTPc_STAT_RESET(p_conn);
+    FTPc_STAT_TS(p_conn, TS_Start);
 
-    while (rx_done != DEF_YES) {
+   *p_err = FTPc_ERR_NONE;
 
-        pkt_size = NetSock_RxData(sock_id,
-                                  p_data,
-                                  data_len,
-                                  NET_SOCK_FLAG_NONE,
-                                  p_err);
-        switch (*p_err) {
-            case NET_SOCK_ERR_NONE:
-                 rx_done = DEF_YES;
-                 break;
+    ctrl_buf_size = sizeof(ctrl_buf);
+                                                                /* Set data type (see Note #2).                         */
+    rtn_code = FTPc_TypeReq(p_conn, FTP_TYPE_IMAGE, ctrl_buf, ctrl_buf_size, p_err);
+    if (rtn_code == DEF_FAIL) {
+        goto exit;
+    }
 
+    sock_dtp_id = FTPc_Conn(p_conn, ctrl_buf, ctrl_buf_size, p_err);
+    if (sock_dtp_id == NET_SOCK_ID_NONE) {
+        rtn_code = DEF_FAIL;
+        goto exit;
+    }
 
-            case NET_ERR_RX:                                    /* If transitory rx err(s), ...                         */
-            case NET_ERR_INIT_INCOMPLETE:
-            case NET_SOCK_ERR_RX_Q_EMPTY:
-            case NET_ERR_FAULT_LOCK_ACQUIRE:
-                 KAL_Dly(p_cfg->CtrlRxMaxDly_ms);
-                 FTPc_TRACE_DBG(("FTPc NetSock_RxData(): error #%u, line #%u.\n", (unsigned int)*p_err, (unsigned int)__LINE__));
-                 break;
+    xfer_open = DEF_NO;
+                                                                /* Send RETR command.                                   */
+    rtn_code = FTPc_CmdTx(p_conn, FTP_CMD_RETR, p_remote_file_name, ctrl_buf, ctrl_buf_size, p_err);
+    if (rtn_code == DEF_FAIL) {
+        rtn_code = DEF_FAIL;
+        goto exit_close_dtp_sock;
+    }
+                                                                /* Receive status line.                                 */
+    reply_code = FTPc_WaitForStatus(p_conn, 0, 0, &err);
+    switch (reply_code) {
+        case FTP_REPLY_CODE_ALREADYOPEN:
+        case FTP_REPLY_CODE_OKAYOPENING:
+             break;
 
+        case FTP_REPLY_CODE_NOTFOUND:
+            *p_err    = FTPc_ERR_FILE_NOT_FOUND;
+             rtn_code = DEF_FAIL;
+             goto exit_close_dtp_sock;
 
-            default:
-                 pkt_size = 0;
-                 rx_done  = DEF_YES;
-                 FTPc_TRACE_DBG(("FTPc NetSock_RxData() failed: error #%u, line #%u.\n", (unsigned int)*p_err, (unsigned int)__LINE__));
-                 break;
+        default:
+            *p_err    = FTPc_ERR_FAULT;
+             rtn_code = DEF_FAIL;
+             goto exit_close_dtp_sock;
+    }
+    FTPc_STAT_TS(p_conn, TS_XferCmd);
+    xfer_open = DEF_YES;
+
+                                                                /* Erase 1st sector while 1st blk is rx'd.              */
+    rtn_code = p_dev->ApiPtr->Erase(p_dev->DevPtr, 0u);
+    if (rtn_code != DEF_OK) {
+       *p_err = FTPc_ERR_BLK_DEV_ERASE;
+        goto exit_close_dtp_sock;
+    }
+
+    NetSock_CfgTimeoutRxQ_Set(sock_dtp_id,
+                              FTPc_DTP_RX_POLL_MS,
+                              &err);
+
+    rx_pkt_cnt = 0;
+    addr       = 0u;
+    blk_len    = 0u;
+    while (DEF_TRUE) {                                          /* Rx into blk buf (see Note #3).                       */
+        rx_len = FTPc_DTP_Rx(p_conn, sock_dtp_id, (CPU_CHAR *)&p_dev->BufPtr[blk_len], (CPU_INT16U)(p_dev->BlkSize - blk_len), p_err);
+        if (rx_len <= 0) {                                      /* End-of-file or err.                                  */
+            break;
+        }
+
+        FTPc_TRACE_EVT(FTPc_TRACE_EVT_DTP_RX, rx_pkt_cnt, rx_len);
+        FTPc_STAT_TS_FIRST(p_conn, TS_FirstByte);
+        FTPc_STAT_ADD(p_conn, RxBytes, rx_len);
+        FTPc_HIST_XFER_ADD(p_conn, rx_len);
+        rx_pkt_cnt++;
+
+        blk_len += (CPU_INT32U)rx_len;
+        if (blk_len < p_dev->BlkSize) {
+            continue;
         }
+
+        rtn_code = FTPc_BlkDevWr(p_dev, addr, p_err);
+        if (rtn_code != DEF_OK) {
+            break;
+        }
+        addr    += blk_len;
+        blk_len  = 0u;
     }
 
-    return (pkt_size);
+    if ((*p_err   == FTPc_ERR_NONE) &&                          /* Wr last partial blk (see Note #4).                   */
+        (blk_len  >  0u)) {
+        Mem_Set(&p_dev->BufPtr[blk_len], FTPc_BLK_DEV_PAD_VAL, p_dev->BlkSize - blk_len);
+        rtn_code = FTPc_BlkDevWr(p_dev, addr, p_err);
+        if (rtn_code == DEF_OK) {
+            addr += blk_len;
+        }
+    }
+    FTPc_STAT_TS(p_conn, TS_LastByte);
+
+   *p_file_size = addr;
+
+exit_close_dtp_sock:
+    rtn_code = FTPc_XferEnd(p_conn, sock_dtp_id, xfer_open, ctrl_buf, ctrl_buf_size, p_err);
+
+exit:
+    return (rtn_code);
 }
 
 
 /*
 *********************************************************************************************************
-*                                               FTPc_Tx()
+*                                         FTPc_BatchModeSet()
 *
-* Description : Transmit data to TCP socket, handling transient errors and incomplete buffer transmit.
+* Description : Enable or disable batch transfer mode on an FTP connection.
 *
-* Argument(s) : sock_id         Socket descriptor/handle identifier of socket to transmit application data.
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
 *
-*               p_data          Pointer to application data to transmit.
+*               en          DEF_ENABLED,  to overlap the data connection setup of the next transfer with
+*                                             the completion of the current one (see Note #1).
+*                           DEF_DISABLED, to set up each data connection when its transfer starts.
 *
-*               data_len        Length  of data to transmit (in octets).
+* Return(s)   : none.
 *
-*               timeout_ms      Transmit timeout value per attempt/retry :
+* Caller(s)   : Application.
 *
-*                                   0,                          if current configured timeout value desired
-*                                                                   [or NO timeout for datagram sockets
-*                                                                   (see Note #5)].
-*                                   NET_TMR_TIME_INFINITE,      if infinite (i.e. NO timeout) value desired.
-*                                   In number of milliseconds,  otherwise.
+* Note(s)     : (1) In batch mode, each successful transfer sends the PASV or EPSV command of the next
+*                   transfer before waiting for its own completion reply. Batch mode SHOULD only be
+*                   enabled while a series of transfers is performed on the connection, since the
+*                   server keeps the passive port reserved until the next transfer starts.
+*
+*               (2) A passive port that has already been received is discarded when batch mode is
+*                   disabled.
+*********************************************************************************************************
+*/
+
+void  FTPc_BatchModeSet (FTPc_CONN    *p_conn,
+                         CPU_BOOLEAN   en)
+{
+    p_conn->BatchEn = en;
+    if (en == DEF_DISABLED) {
+        p_conn->PasvRdy = DEF_NO;                               /* See Note #2.                                         */
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                            FTPc_TypeSet()
 *
-*               retry_max       Maximum number of consecutive socket transmit retries.
+* Description : Set the data type of the following transfers on an FTP connection.
 *
-*               time_dly_ms     Transitory transmit delay value, in milliseconds.
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
 *
-*               p_err           Pointer to variable that will receive the return error code from NetSock_TxData().
+*               type        Data type :
 *
-* Return(s)   : DEF_FAIL        transmission failed.
-*               DEF_OK          transmission successful.
+*                               FTP_TYPE_IMAGE      Data is transferred unchanged (default).
+*                               FTP_TYPE_ASCII      Text data; local LF line endings are converted to & from
+*                                                   CRLF network line endings (see Note #1).
 *
-* Caller(s)   : FTPc_Open(),
-*               FTPc_Close(),
-*               FTPc_RecvBuf(),
-*               FTPc_SendBuf(),
-*               FTPc_RecvFile(),
-*               FTPc_SendFile().
+* Return(s)   : DEF_FAIL        data type not supported.
+*               DEF_OK          data type set.
 *
-* Note(s)     : None.
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) Lines that already end with CRLF are transmitted unchanged.
 *********************************************************************************************************
 */
 
-static  CPU_BOOLEAN  FTPc_Tx (CPU_INT32S   sock_id,
-                              CPU_CHAR    *p_data,
-                              CPU_INT16U   data_len,
-                              CPU_INT32U   timeout_ms,
-                              CPU_INT16U   retry_max,
-                              CPU_INT32U   time_dly_ms,
-                              NET_ERR     *p_err)
+CPU_BOOLEAN  FTPc_TypeSet (FTPc_CONN  *p_conn,
+                           CPU_CHAR    type)
 {
-    CPU_CHAR     *tx_buf;
-    CPU_INT16S    tx_buf_len;
-    CPU_INT16S    tx_len;
-    CPU_INT16S    tx_len_tot;
-    CPU_INT32U    timeout_ms_cfgd;
-    CPU_INT32U    tx_retry_cnt;
-    CPU_BOOLEAN   tx_done;
-    CPU_BOOLEAN   tx_dly;
-
-
-    if (timeout_ms != 0) {
-        timeout_ms_cfgd = NetSock_CfgTimeoutTxQ_Get_ms(sock_id, p_err);
-        NetSock_CfgTimeoutRxQ_Set(sock_id, timeout_ms, p_err);
+    if ((type != FTP_TYPE_IMAGE) &&
+        (type != FTP_TYPE_ASCII)) {
+        return (DEF_FAIL);
     }
 
-    tx_len_tot   = 0;
-    tx_retry_cnt = 0;
-    tx_done      = DEF_NO;
-    tx_dly       = DEF_NO;
-    while ((tx_len_tot   <  data_len ) &&                       /* While tx tot len < buf len ...                       */
-           (tx_retry_cnt <  retry_max) &&                       /* ... & tx retry   < MAX     ...                       */
-           (tx_done      == DEF_NO   )) {                       /* ... & tx NOT done;         ...                       */
+    p_conn->Type = type;
+
+    return (DEF_OK);
+}
+
+
+#ifdef  NET_SECURE_MODULE_EN
+/*
+*********************************************************************************************************
+*                                            FTPc_ProtSet()
+*
+* Description : Set the data protection level of the following transfers on a secure FTP connection.
+*
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
+*
+*               prot        Data protection level :
+*
+*                               FTP_PROT_PRIVATE    Data connections are secured (default).
+*                               FTP_PROT_CLEAR      Data connections are not secured (see Note #1).
+*
+* Return(s)   : DEF_FAIL        protection level not supported, or connection not secured.
+*               DEF_OK          protection level set.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) The control connection remains secured, so the credentials & commands are still
+*                   protected. The clear level SHOULD only be used for public data whose transfer
+*                   throughput is limited by the cost of the encryption; the throughput of both levels
+*                   MAY be compared with FTPc_StatGet() or FTPc_HistGet().
+*
+*               (2) The PROT command is sent by the next transfer only if the level differs from the
+*                   level already set on the server.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  FTPc_ProtSet (FTPc_CONN  *p_conn,
+                           CPU_CHAR    prot)
+{
+    if ((prot != FTP_PROT_PRIVATE) &&
+        (prot != FTP_PROT_CLEAR  )) {
+        return (DEF_FAIL);
+    }
+
+    if (p_conn->SecureCfgPtr == DEF_NULL) {
+        return (DEF_FAIL);
+    }
+
+    p_conn->Prot = prot;                                        /* See Note #2.                                         */
+
+    return (DEF_OK);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                              FTPc_Dele()
+*
+* Description : Delete a file on an FTP server.
+*
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
+*
+*               p_path      Pointer to name of the file to delete.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FTPc_ERR_NONE                   Operation successful.
+*                               FTPc_ERR_FAULT                  Invalid path.
+*                               FTPc_ERR_CMD_LEN                Command longer than control buffer.
+*                               FTPc_ERR_TX_CMD                 Sending Command failed.
+*                               FTPc_ERR_FILE_NOT_FOUND         File or directory not found on server.
+*                               FTPc_ERR_RX_CMD_RESP_FAIL       Operation refused by server.
+*
+* Return(s)   : DEF_FAIL        operation failed.
+*               DEF_OK          operation successful.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : None.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  FTPc_Dele (FTPc_CONN  *p_conn,
+                       CPU_CHAR   *p_path,
+                       FTPc_ERR   *p_err)
+{
+    FTPc_REMOTE_OP  op;
+    CPU_BOOLEAN     rtn_code;
+
+
+    op.Op         = FTP_CMD_DELE;
+    op.PathPtr    = p_path;
+    op.NewPathPtr = DEF_NULL;
+
+    rtn_code      = FTPc_RemoteOpBatch(p_conn, &op, 1u, p_err);
+
+    return (rtn_code);
+}
+
+
+/*
+*********************************************************************************************************
+*                                             FTPc_Rename()
+*
+* Description : Rename a file or directory on an FTP server.
+*
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
+*
+*               p_path      Pointer to current name of the file or directory.
+*
+*               p_path_new  Pointer to new name of the file or directory.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FTPc_ERR_NONE                   Operation successful.
+*                               FTPc_ERR_FAULT                  Invalid path.
+*                               FTPc_ERR_CMD_LEN                Command longer than control buffer.
+*                               FTPc_ERR_TX_CMD                 Sending Command failed.
+*                               FTPc_ERR_FILE_NOT_FOUND         File or directory not found on server.
+*                               FTPc_ERR_RX_CMD_RESP_FAIL       Operation refused by server.
+*
+* Return(s)   : DEF_FAIL        operation failed.
+*               DEF_OK          operation successful.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) The RNFR & RNTO commands are sent back-to-back (see FTPc_RemoteOpBatch() Note #2).
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  FTPc_Rename (FTPc_CONN  *p_conn,
+                          CPU_CHAR   *p_path,
+                          CPU_CHAR   *p_path_new,
+                          FTPc_ERR   *p_err)
+{
+    FTPc_REMOTE_OP  op;
+    CPU_BOOLEAN     rtn_code;
+
+
+    op.Op         = FTP_CMD_RNFR;                               /* See Note #1.                                         */
+    op.PathPtr    = p_path;
+    op.NewPathPtr = p_path_new;
+
+    rtn_code      = FTPc_RemoteOpBatch(p_conn, &op, 1u, p_err);
+
+    return (rtn_code);
+}
+
+
+/*
+*********************************************************************************************************
+*                                             FTPc_MkDir()
+*
+* Description : Create a directory on an FTP server.
+*
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
+*
+*               p_path      Pointer to name of the directory to create.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FTPc_ERR_NONE                   Operation successful.
+*                               FTPc_ERR_FAULT                  Invalid path.
+*                               FTPc_ERR_CMD_LEN                Command longer than control buffer.
+*                               FTPc_ERR_TX_CMD                 Sending Command failed.
+*                               FTPc_ERR_FILE_NOT_FOUND         File or directory not found on server.
+*                               FTPc_ERR_RX_CMD_RESP_FAIL       Operation refused by server.
+*
+* Return(s)   : DEF_FAIL        operation failed.
+*               DEF_OK          operation successful.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : None.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  FTPc_MkDir (FTPc_CONN  *p_conn,
+                        CPU_CHAR   *p_path,
+                        FTPc_ERR   *p_err)
+{
+    FTPc_REMOTE_OP  op;
+    CPU_BOOLEAN     rtn_code;
+
+
+    op.Op         = FTP_CMD_MKD;
+    op.PathPtr    = p_path;
+    op.NewPathPtr = DEF_NULL;
+
+    rtn_code      = FTPc_RemoteOpBatch(p_conn, &op, 1u, p_err);
+
+    return (rtn_code);
+}
+
+
+/*
+*********************************************************************************************************
+*                                             FTPc_RmDir()
+*
+* Description : Remove a directory on an FTP server.
+*
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
+*
+*               p_path      Pointer to name of the directory to remove.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FTPc_ERR_NONE                   Operation successful.
+*                               FTPc_ERR_FAULT                  Invalid path.
+*                               FTPc_ERR_CMD_LEN                Command longer than control buffer.
+*                               FTPc_ERR_TX_CMD                 Sending Command failed.
+*                               FTPc_ERR_FILE_NOT_FOUND         File or directory not found on server.
+*                               FTPc_ERR_RX_CMD_RESP_FAIL       Operation refused by server.
+*
+* Return(s)   : DEF_FAIL        operation failed.
+*               DEF_OK          operation successful.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : None.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  FTPc_RmDir (FTPc_CONN  *p_conn,
+                        CPU_CHAR   *p_path,
+                        FTPc_ERR   *p_err)
+{
+    FTPc_REMOTE_OP  op;
+    CPU_BOOLEAN     rtn_code;
+
+
+    op.Op         = FTP_CMD_RMD;
+    op.PathPtr    = p_path;
+    op.NewPathPtr = DEF_NULL;
+
+    rtn_code      = FTPc_RemoteOpBatch(p_conn, &op, 1u, p_err);
+
+    return (rtn_code);
+}
+
+
+/*
+*********************************************************************************************************
+*                                             FTPc_ChDir()
+*
+* Description : Change the working directory of an FTP connection.
+*
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
+*
+*               p_path      Pointer to name of the new working directory.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FTPc_ERR_NONE                   Operation successful.
+*                               FTPc_ERR_FAULT                  Invalid path.
+*                               FTPc_ERR_CMD_LEN                Command longer than control buffer.
+*                               FTPc_ERR_TX_CMD                 Sending Command failed.
+*                               FTPc_ERR_FILE_NOT_FOUND         File or directory not found on server.
+*                               FTPc_ERR_RX_CMD_RESP_FAIL       Operation refused by server.
+*
+* Return(s)   : DEF_FAIL        operation failed.
+*               DEF_OK          operation successful.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : None.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  FTPc_ChDir (FTPc_CONN  *p_conn,
+                        CPU_CHAR   *p_path,
+                        FTPc_ERR   *p_err)
+{
+    FTPc_REMOTE_OP  op;
+    CPU_BOOLEAN     rtn_code;
+
+
+    op.Op         = FTP_CMD_CWD;
+    op.PathPtr    = p_path;
+    op.NewPathPtr = DEF_NULL;
+
+    rtn_code      = FTPc_RemoteOpBatch(p_conn, &op, 1u, p_err);
+
+    return (rtn_code);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          FTPc_WorkDirGet()
+*
+* Description : Get the working directory of an FTP connection.
+*
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
+*
+*               p_path      Pointer to buffer that will receive the name of the working directory.
+*
+*               path_len    Size of the buffer.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FTPc_ERR_NONE                   Working directory received.
+*                               FTPc_ERR_FAULT_NULL_PTR         Invalid buffer.
+*                               FTPc_ERR_CMD_LEN                Command longer than control buffer.
+*                               FTPc_ERR_TX_CMD                 Sending Command failed.
+*                               FTPc_ERR_RX_CMD_RESP_FAIL       Receiving Command response failed.
+*                               FTPc_ERR_RX_CMD_RESP_INVALID    Invalid reply, or buffer too small.
+*
+* Return(s)   : DEF_FAIL        operation failed.
+*               DEF_OK          operation successful.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) The directory name is enclosed in quotes in the PWD reply; quotes within the name are
+*                   doubled (see RFC 959, Appendix II).
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  FTPc_WorkDirGet (FTPc_CONN   *p_conn,
+                              CPU_CHAR    *p_path,
+                              CPU_SIZE_T   path_len,
+                              FTPc_ERR    *p_err)
+{
+    CPU_CHAR      ctrl_buf[FTPc_CTRL_NET_BUF_SIZE];
+    CPU_CHAR     *p_reply;
+    CPU_SIZE_T    len;
+    CPU_INT32U    reply_code;
+    CPU_BOOLEAN   rtn_code;
+    NET_ERR       err;
+
+
+    if ((p_path   == DEF_NULL) ||
+        (path_len == 0u)) {
+       *p_err = FTPc_ERR_FAULT_NULL_PTR;
+        return (DEF_FAIL);
+    }
+
+    rtn_code = FTPc_CmdTx(p_conn, FTP_CMD_PWD, DEF_NULL, ctrl_buf, sizeof(ctrl_buf), p_err);
+    if (rtn_code == DEF_FAIL) {
+        return (DEF_FAIL);
+    }
+                                                                /* Receive status line.                                 */
+    reply_code = FTPc_WaitForStatus(p_conn, ctrl_buf, sizeof(ctrl_buf), &err);
+    if (reply_code != FTP_REPLY_CODE_PATHNAME) {
+       *p_err = FTPc_ERR_RX_CMD_RESP_FAIL;
+        return (DEF_FAIL);
+    }
 
-        if (tx_dly == DEF_YES) {                                /* Dly tx, if req'd.                                    */
-            KAL_Dly(time_dly_ms);
+    p_reply = Str_Char_N(ctrl_buf, sizeof(ctrl_buf), '"');      /* Copy quoted dir name (see Note #1).                  */
+    if (p_reply == DEF_NULL) {
+       *p_err = FTPc_ERR_RX_CMD_RESP_INVALID;
+        return (DEF_FAIL);
+    }
+    p_reply++;
+
+    len = 0u;
+    while (*p_reply != (CPU_CHAR)'\0') {
+        if (*p_reply == '"') {
+            if (p_reply[1] != '"') {                            /* Closing quote.                                       */
+                break;
+            }
+            p_reply++;                                          /* Doubled quote.                                       */
         }
+        if (len >= (path_len - 1u)) {
+            break;
+        }
+        p_path[len] = *p_reply;
+        len++;
+        p_reply++;
+    }
+    p_path[len] = (CPU_CHAR)'\0';
 
-        tx_buf     = p_data   + tx_len_tot;
-        tx_buf_len = data_len - tx_len_tot;
-        tx_len     = NetSock_TxData(sock_id,                    /* ... tx data.                                         */
-                                    tx_buf,
-                                    tx_buf_len,
-                                    NET_SOCK_FLAG_NONE,
-                                    p_err);
-        switch (*p_err) {
-            case NET_SOCK_ERR_NONE:
-                 if (tx_len > 0) {                              /* If          tx len > 0, ...                          */
-                     tx_len_tot += tx_len;                      /* ... inc tot tx len.                                  */
-                     tx_dly      = DEF_NO;
-                 } else {                                       /* Else dly next tx.                                    */
-                     tx_dly      = DEF_YES;
+    if (*p_reply != '"') {                                      /* No closing quote or buf too small.                   */
+       *p_err = FTPc_ERR_RX_CMD_RESP_INVALID;
+        return (DEF_FAIL);
+    }
+
+   *p_err = FTPc_ERR_NONE;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FTPc_RemoteOpBatch()
+*
+* Description : Perform a batch of operations on remote files & directories.
+*
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
+*
+*               p_op_tbl    Pointer to table of remote operations, performed in order (see Note #1).
+*
+*               op_nbr      Number of remote operations in table.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FTPc_ERR_NONE                   All operations successful.
+*                               FTPc_ERR_FAULT_NULL_PTR         Invalid operation table.
+*                               FTPc_ERR_CMD_LEN                Command longer than control buffer.
+*                               FTPc_ERR_TX_CMD                 Sending Command failed.
+*                               FTPc_ERR_RX_CMD_RESP_FAIL       Receiving Command response failed.
+*                               Error code of the last failed operation, otherwise.
+*
+* Return(s)   : DEF_FAIL        one or more operations failed.
+*               DEF_OK          all operations successful.
+*
+* Caller(s)   : Application,
+*               FTPc_Dele(),
+*               FTPc_Rename(),
+*               FTPc_MkDir(),
+*               FTPc_RmDir(),
+*               FTPc_ChDir().
+*
+* Note(s)     : (1) See 'ftp-c.h  FTPc REMOTE OPERATION DATA TYPE'. The Err field of each operation
+*                   receives its result :
+*
+*                       FTPc_ERR_NONE                   Operation successful.
+*                       FTPc_ERR_FAULT                  Invalid operation; not sent to the server.
+*                       FTPc_ERR_CMD_LEN                Path too long for control buffer; not sent to
+*                                                           the server (see Note #7).
+*                       FTPc_ERR_FILE_NOT_FOUND         File or directory not found on server.
+*                       FTPc_ERR_RX_CMD_RESP_FAIL       Operation refused by server, or its reply was
+*                                                           not received (see Note #6).
+*                       FTPc_ERR_TX_CMD                 Operation not performed; the batch was aborted.
+*
+*               (2) Up to FTPc_REMOTE_OP_WIN_SIZE commands are written back-to-back on the control
+*                   connection before their replies are received; the replies are then matched with the
+*                   commands in order, since the server processes commands sequentially. A batch of
+*                   operations therefore costs about one round-trip per window instead of one per
+*                   command. The window bounds the amount of replies queued by the server so that it
+*                   never stops reading commands.
+*
+*               (3) The round-trip latency of pipelined commands is not recorded since their replies are
+*                   queued behind the replies of the previous commands.
+*
+*               (4) The cached metadata of the paths of each operation is invalidated. Changing the working
+*                   directory invalidates the whole cache since cached relative paths no longer apply.
+*
+*               (5) Since a CWD command changes the meaning of the relative paths of the operations that
+*                   follow it, it is not pipelined : it is sent once the replies of all previous commands
+*                   are received & the following commands are only sent once it succeeded. If it fails,
+*                   the following operations are not performed.
+*
+*               (6) The batch is aborted if a command cannot be sent or a reply is not received on the
+*                   control connection. Operations whose commands were sent but whose replies were not
+*                   received MAY have been performed by the server.
+*
+*               (7) The length of the commands of each operation is validated before the batch is sent,
+*                   so that a rename is never left half sent (RNFR without RNTO) on the control
+*                   connection.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  FTPc_RemoteOpBatch (FTPc_CONN       *p_conn,
+                                 FTPc_REMOTE_OP  *p_op_tbl,
+                                 CPU_SIZE_T       op_nbr,
+                                 FTPc_ERR        *p_err)
+{
+    CPU_CHAR         ctrl_buf[FTPc_CTRL_NET_BUF_SIZE];
+    FTPc_REMOTE_OP  *p_op;
+    CPU_SIZE_T       op_ix;
+    CPU_SIZE_T       op_ix_tx;
+    CPU_SIZE_T       op_ix_rx;
+    CPU_SIZE_T       cmd_len;
+    CPU_SIZE_T       cmd_len_rnto;
+    CPU_INT08U       cmd_nbr;
+    CPU_INT08U       cmd_nbr_op;
+    CPU_INT32U       reply_code;
+    CPU_INT32U       reply_code_ok;
+    CPU_BOOLEAN      cwd_pend;
+    CPU_BOOLEAN      rtn_code;
+    FTPc_ERR         err_tx;
+    NET_ERR          err;
+
+
+    if ((p_op_tbl == DEF_NULL) &&
+        (op_nbr   >  0u)) {
+       *p_err = FTPc_ERR_FAULT_NULL_PTR;
+        return (DEF_FAIL);
+    }
+
+   *p_err = FTPc_ERR_NONE;
+    for (op_ix = 0u; op_ix < op_nbr; op_ix++) {                 /* Validate ops.                                        */
+        p_op      = &p_op_tbl[op_ix];
+        p_op->Err =  FTPc_ERR_NONE;
+        switch (p_op->Op) {
+            case FTP_CMD_DELE:
+            case FTP_CMD_MKD:
+            case FTP_CMD_RMD:
+            case FTP_CMD_CWD:
+                 if (p_op->PathPtr == DEF_NULL) {
+                     p_op->Err = FTPc_ERR_FAULT;
                  }
-                 tx_retry_cnt = 0;
                  break;
 
 
-            case NET_ERR_TX:                                    /* If transitory tx err(s), ...                         */
-            case NET_ERR_INIT_INCOMPLETE:
-            case NET_SOCK_ERR_PORT_NBR_NONE_AVAIL:
-            case NET_CONN_ERR_NONE_AVAIL:
-#ifdef  NET_IPv4_MODULE_EN
-            case NET_IPv4_ERR_ADDR_NONE_AVAIL:
-            case NET_IPv4_ERR_ADDR_CFG_IN_PROGRESS:
-#endif
-#ifdef  NET_IPv6_MODULE_EN
-            case NET_IPv6_ERR_ADDR_NONE_AVAIL:
-            case NET_IPv6_ERR_ADDR_CFG_IN_PROGRESS:
-#endif
-            case NET_ERR_FAULT_LOCK_ACQUIRE:
-                 tx_dly = DEF_YES;                              /* ... dly next tx.                                     */
-                 tx_retry_cnt++;
-                 break;
+            case FTP_CMD_RNFR:
+                 if ((p_op->PathPtr    == DEF_NULL) ||
+                     (p_op->NewPathPtr == DEF_NULL)) {
+                     p_op->Err = FTPc_ERR_FAULT;
+                 }
+                 break;
+
+
+            default:
+                 p_op->Err = FTPc_ERR_FAULT;
+                 break;
+        }
+        if (p_op->Err == FTPc_ERR_NONE) {                       /* Validate cmd len (see Note #7).                      */
+            cmd_len = Str_Len(FTPc_Cmd[p_op->Op].CmdStr) + Str_Len_N(p_op->PathPtr, sizeof(ctrl_buf));
+            if (p_op->Op == FTP_CMD_RNFR) {
+                cmd_len_rnto = Str_Len(FTPc_Cmd[FTP_CMD_RNTO].CmdStr) + Str_Len_N(p_op->NewPathPtr, sizeof(ctrl_buf));
+                cmd_len      = DEF_MAX(cmd_len, cmd_len_rnto);
+            }
+            if ((cmd_len + 3u) >= sizeof(ctrl_buf)) {           /* Space & CRLF.                                        */
+                p_op->Err = FTPc_ERR_CMD_LEN;
+            }
+        }
+        if (p_op->Err != FTPc_ERR_NONE) {
+           *p_err = p_op->Err;
+        }
+    }
+
+    op_ix_tx = 0u;
+    op_ix_rx = 0u;
+    cmd_nbr  = 0u;
+    cwd_pend = DEF_NO;
+    while (op_ix_rx < op_nbr) {
+        while (op_ix_tx < op_nbr) {                             /* Tx cmds up to window size (see Note #2).             */
+            p_op = &p_op_tbl[op_ix_tx];
+            if (p_op->Err != FTPc_ERR_NONE) {                   /* Skip invalid op.                                     */
+                op_ix_tx++;
+                continue;
+            }
+
+            if ((cwd_pend == DEF_YES) ||                        /* See Note #5.                                         */
+               ((p_op->Op == FTP_CMD_CWD) &&
+                (cmd_nbr  >  0u        ))) {
+                break;
+            }
+
+            cmd_nbr_op = (p_op->Op == FTP_CMD_RNFR) ? 2u : 1u;
+            if ((cmd_nbr + cmd_nbr_op) > FTPc_REMOTE_OP_WIN_SIZE) {
+                break;
+            }
+
+            if (p_op->Op == FTP_CMD_CWD) {                      /* Invalidate cached metadata (see Note #4).            */
+                FTPc_META_CACHE_INV(p_conn, DEF_NULL);
+            } else {
+                FTPc_META_CACHE_INV(p_conn, p_op->PathPtr);
+            }
+
+            rtn_code = FTPc_CmdTx(p_conn, p_op->Op, p_op->PathPtr, ctrl_buf, sizeof(ctrl_buf), &err_tx);
+            if ((rtn_code == DEF_OK      ) &&
+                (p_op->Op == FTP_CMD_RNFR)) {
+                FTPc_HIST_CMD_CLR(p_conn);                      /* See Note #3.                                         */
+                FTPc_META_CACHE_INV(p_conn, p_op->NewPathPtr);
+                rtn_code = FTPc_CmdTx(p_conn, FTP_CMD_RNTO, p_op->NewPathPtr, ctrl_buf, sizeof(ctrl_buf), &err_tx);
+            }
+            if (rtn_code == DEF_FAIL) {                         /* Abort batch if ctrl conn failed (see Note #6).       */
+                FTPc_RemoteOpAbort(p_op_tbl, op_ix_rx, op_ix_tx, op_nbr);
+               *p_err = err_tx;
+                return (DEF_FAIL);
+            }
+            if (cmd_nbr > 0u) {
+                FTPc_HIST_CMD_CLR(p_conn);                      /* See Note #3.                                         */
+            }
+
+            cmd_nbr += cmd_nbr_op;
+            op_ix_tx++;
+            if (p_op->Op == FTP_CMD_CWD) {                      /* Wait for CWD reply (see Note #5).                    */
+                cwd_pend = DEF_YES;
+            }
+        }
+
+        p_op = &p_op_tbl[op_ix_rx];
+        op_ix_rx++;
+        if (p_op->Err != FTPc_ERR_NONE) {                       /* No reply for invalid op.                             */
+            continue;
+        }
+                                                                /* Receive status line(s) of op.                        */
+        reply_code_ok = FTP_REPLY_CODE_ACTIONCOMPLETE;
+        cmd_nbr_op    = 1u;
+        reply_code    = FTPc_WaitForStatus(p_conn, 0, 0, &err);
+        switch (p_op->Op) {
+            case FTP_CMD_MKD:
+                 reply_code_ok = FTP_REPLY_CODE_PATHNAME;
+                 break;
+
+
+            case FTP_CMD_RNFR:                                  /* Always rx RNTO reply.                                */
+                 cmd_nbr_op = 2u;
+                 if (reply_code == FTP_REPLY_CODE_NEEDMOREINFO) {
+                     reply_code  = FTPc_WaitForStatus(p_conn, 0, 0, &err);
+                 } else {
+                    (void)FTPc_WaitForStatus(p_conn, 0, 0, &err);
+                 }
+                 break;
+
+
+            default:
+                 break;
+        }
+        cmd_nbr -= cmd_nbr_op;
+
+        if (reply_code != reply_code_ok) {
+            p_op->Err = (reply_code == FTP_REPLY_CODE_NOTFOUND) ? FTPc_ERR_FILE_NOT_FOUND
+                                                                : FTPc_ERR_RX_CMD_RESP_FAIL;
+           *p_err     =  p_op->Err;
+        }
+
+        if (p_conn->CtrlFail == DEF_YES) {                      /* Abort batch if reply lost (see Note #6).             */
+            FTPc_RemoteOpAbort(p_op_tbl, op_ix_rx, op_ix_tx, op_nbr);
+           *p_err = FTPc_ERR_RX_CMD_RESP_FAIL;
+            return (DEF_FAIL);
+        }
+
+        if (p_op->Op == FTP_CMD_CWD) {
+            cwd_pend = DEF_NO;
+            if (p_op->Err != FTPc_ERR_NONE) {                   /* Following ops depend on CWD (see Note #5).           */
+                FTPc_RemoteOpAbort(p_op_tbl, op_ix_rx, op_ix_tx, op_nbr);
+                return (DEF_FAIL);
+            }
+        }
+    }
+
+    rtn_code = (*p_err == FTPc_ERR_NONE) ? DEF_OK : DEF_FAIL;
+
+    return (rtn_code);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          FTPc_FileInfoGet()
+*
+* Description : Get the metadata of a file on an FTP server.
+*
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
+*
+*               p_path      Pointer to name of the file in FTP server.
+*
+*               p_info      Pointer to variable that will receive the file metadata.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FTPc_ERR_NONE                   Metadata received (see Note #2).
+*                               FTPc_ERR_FAULT_NULL_PTR         Invalid path or metadata pointer.
+*                               FTPc_ERR_CMD_LEN                Command longer than control buffer.
+*                               FTPc_ERR_TX_CMD                 Sending Command failed.
+*                               FTPc_ERR_RX_CMD_RESP_FAIL       Receiving Command response failed.
+*
+* Return(s)   : DEF_FAIL        metadata not available.
+*               DEF_OK          metadata available.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) When FTPc_CFG_META_CACHE_EN is DEF_ENABLED, metadata received less than
+*                   FTPc_CFG_META_CACHE_TTL_MS milliseconds ago is returned from the cache of the
+*                   connection without contacting the server (see 'ftp-c.h  FTPc METADATA CACHE').
+*
+*               (2) A file that does not exist on the server is reported with Exists set to DEF_NO; this
+*                   result is cached as well.
+*
+*               (3) The SIZE & MDTM commands are sent back-to-back so that both are answered within a
+*                   single round-trip. The IMAGE type is set first since the result of SIZE depends on
+*                   the data type. If the server does not support MDTM, the modification time is null.
+*
+*               (4) If the SIZE reply is not received, the MDTM reply is not waited for since it would
+*                   only stall the failure for another reply timeout. The control connection is then out
+*                   of sync & MUST be closed (see FTPc_WaitForStatus() Note #4); no metadata is cached.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  FTPc_FileInfoGet (FTPc_CONN       *p_conn,
+                               CPU_CHAR        *p_path,
+                               FTPc_FILE_INFO  *p_info,
+                               FTPc_ERR        *p_err)
+{
+#if (FTPc_CFG_META_CACHE_EN == DEF_ENABLED)
+    FTPc_META_ENTRY  *p_entry;
+#endif
+    CPU_CHAR          ctrl_buf[FTPc_CTRL_NET_BUF_SIZE];
+    CPU_CHAR         *p_reply;
+    CPU_INT32U        reply_code;
+    CPU_INT32U        reply_code_mdtm;
+    CPU_INT08U        ix;
+    CPU_INT16U        val;
+    CPU_BOOLEAN       rtn_code;
+    NET_ERR           err;
+
+
+    if ((p_path == DEF_NULL) ||
+        (p_info == DEF_NULL)) {
+       *p_err = FTPc_ERR_FAULT_NULL_PTR;
+        return (DEF_FAIL);
+    }
+
+#if (FTPc_CFG_META_CACHE_EN == DEF_ENABLED)
+    p_entry = FTPc_MetaCacheGet(p_conn, p_path);                /* See Note #1.                                         */
+    if (p_entry != DEF_NULL) {
+       *p_info = p_entry->Info;
+       *p_err  = FTPc_ERR_NONE;
+        return (DEF_OK);
+    }
+#endif
+
+    rtn_code = FTPc_TypeReq(p_conn, FTP_TYPE_IMAGE, ctrl_buf, sizeof(ctrl_buf), p_err);
+    if (rtn_code == DEF_FAIL) {                                 /* See Note #3.                                         */
+        return (DEF_FAIL);
+    }
+
+    rtn_code = FTPc_CmdTx(p_conn, FTP_CMD_SIZE, p_path, ctrl_buf, sizeof(ctrl_buf), p_err);
+    if (rtn_code == DEF_OK) {
+        rtn_code = FTPc_CmdTx(p_conn, FTP_CMD_MDTM, p_path, ctrl_buf, sizeof(ctrl_buf), p_err);
+        FTPc_HIST_CMD_CLR(p_conn);
+    }
+    if (rtn_code == DEF_FAIL) {
+        return (DEF_FAIL);
+    }
+
+    Mem_Clr(p_info, sizeof(FTPc_FILE_INFO));
+                                                                /* Receive SIZE status line.                            */
+    reply_code = FTPc_WaitForStatus(p_conn, ctrl_buf, sizeof(ctrl_buf), &err);
+    if ((reply_code       == 0u     ) ||                        /* See Note #4.                                         */
+        (p_conn->CtrlFail == DEF_YES)) {
+       *p_err = FTPc_ERR_RX_CMD_RESP_FAIL;
+        return (DEF_FAIL);
+    }
+    if (reply_code == FTP_REPLY_CODE_FILESTATUS) {
+        p_info->Exists = DEF_YES;
+        p_info->Size   = Str_ParseNbr_Int32U(&ctrl_buf[FTP_REPLY_CODE_LEN + 1u], DEF_NULL, 10);
+    }
+                                                                /* Receive MDTM status line.                            */
+    reply_code_mdtm = FTPc_WaitForStatus(p_conn, ctrl_buf, sizeof(ctrl_buf), &err);
+    if (p_conn->CtrlFail == DEF_YES) {                          /* See Note #4.                                         */
+       *p_err = FTPc_ERR_RX_CMD_RESP_FAIL;
+        return (DEF_FAIL);
+    }
+    if ((reply_code      == FTP_REPLY_CODE_FILESTATUS) &&
+        (reply_code_mdtm == FTP_REPLY_CODE_FILESTATUS)) {
+        p_reply = &ctrl_buf[FTP_REPLY_CODE_LEN + 1u];           /* Parse YYYYMMDDHHMMSS time-val.                       */
+        for (ix = 0u; ix < 14u; ix++) {
+            if (ASCII_IsDig(p_reply[ix]) == DEF_NO) {
+                break;
+            }
+        }
+        if (ix == 14u) {
+            val = 0u;
+            for (ix = 0u; ix < 4u; ix++) {
+                val = (val * 10u) + (p_reply[ix] - '0');
+            }
+            p_info->Year  =  val;
+            p_info->Month = ((p_reply[ 4] - '0') * 10u) + (p_reply[ 5] - '0');
+            p_info->Day   = ((p_reply[ 6] - '0') * 10u) + (p_reply[ 7] - '0');
+            p_info->Hr    = ((p_reply[ 8] - '0') * 10u) + (p_reply[ 9] - '0');
+            p_info->Min   = ((p_reply[10] - '0') * 10u) + (p_reply[11] - '0');
+            p_info->Sec   = ((p_reply[12] - '0') * 10u) + (p_reply[13] - '0');
+        }
+    }
+
+    if ((reply_code != FTP_REPLY_CODE_FILESTATUS) &&            /* See Note #2.                                         */
+        (reply_code != FTP_REPLY_CODE_NOTFOUND  )) {
+       *p_err = FTPc_ERR_RX_CMD_RESP_FAIL;
+        return (DEF_FAIL);
+    }
+
+#if (FTPc_CFG_META_CACHE_EN == DEF_ENABLED)
+    FTPc_MetaCachePut(p_conn, p_path, p_info);
+#endif
+
+   *p_err = FTPc_ERR_NONE;
+
+    return (DEF_OK);
+}
+
+
+#if (FTPc_CFG_META_CACHE_EN == DEF_ENABLED)
+/*
+*********************************************************************************************************
+*                                          FTPc_FileInfoPut()
+*
+* Description : Store the metadata of a file of an FTP server in the metadata cache of a connection.
+*
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
+*
+*               p_path      Pointer to name of the file in FTP server.
+*
+*               p_info      Pointer to file metadata.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) The application MAY populate the cache with the metadata of the files of a directory
+*                   listing, so that the following calls to FTPc_FileInfoGet() for these files do not
+*                   contact the server.
+*********************************************************************************************************
+*/
+
+void  FTPc_FileInfoPut (FTPc_CONN       *p_conn,
+                        CPU_CHAR        *p_path,
+                        FTPc_FILE_INFO  *p_info)
+{
+    if ((p_path == DEF_NULL) ||
+        (p_info == DEF_NULL)) {
+        return;
+    }
+
+    FTPc_MetaCachePut(p_conn, p_path, p_info);
+}
+#endif
+
+
+#if (FTPc_CFG_RATE_LIMIT_EN == DEF_ENABLED)
+/*
+*********************************************************************************************************
+*                                         FTPc_RateLimitSet()
+*
+* Description : Set the data transfer rate limit of a connection, or of all connections.
+*
+* Argument(s) : p_conn      Pointer to FTPc Connection object, or DEF_NULL to set the global limit.
+*
+*               rate        Sustained rate, in octets per second; 0 to disable the limit.
+*
+*               burst       Maximum number of octets transferred at full speed after an idle period.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) Data transfers of a connection are limited by both its own limit & the global limit
+*                   (see 'ftp-c.h  FTPc RATE LIMIT  Note #1').
+*
+*               (2) The limit MAY be changed at any time, including during a transfer of the connection.
+*                   The limit of a connection is reset by FTPc_Open().
+*
+*               (3) A burst lower than the size of a single data read or write still limits the rate,
+*                   but with a coarser granularity.
+*********************************************************************************************************
+*/
+
+void  FTPc_RateLimitSet (FTPc_CONN   *p_conn,
+                         CPU_INT32U   rate,
+                         CPU_INT32U   burst)
+{
+    FTPc_RATE_LIMIT  *p_bucket;
+    CPU_SR_ALLOC();
+
+
+    p_bucket = (p_conn != DEF_NULL) ? &p_conn->RateLimit : &FTPc_RateLimitGlobal;
+
+    CPU_CRITICAL_ENTER();                                       /* See Note #2.                                         */
+    p_bucket->Rate   = rate;
+    p_bucket->Burst  = burst;
+    p_bucket->Tokens = (CPU_INT32S)DEF_MIN(burst, DEF_INT_32S_MAX_VAL);
+    p_bucket->TS_ms  = (CPU_INT32U)NetUtil_TS_Get_ms();
+    CPU_CRITICAL_EXIT();
+}
+#endif
+
+
+#if (FTPc_CFG_SCHED_EN == DEF_ENABLED)
+/*
+*********************************************************************************************************
+*                                            FTPc_PrioSet()
+*
+* Description : Set the priority class of the transfers of a connection.
+*
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
+*
+*               prio        Priority class :
+*
+*                               FTPc_PRIO_HIGH      Urgent transfers.
+*                               FTPc_PRIO_NORMAL    Default priority class.
+*                               FTPc_PRIO_LOW       Background transfers.
+*
+* Return(s)   : DEF_FAIL        priority class not supported.
+*               DEF_OK          priority class set.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) The priority class MAY be changed during a transfer of the connection; it applies from
+*                   the next chunk of data.
+*
+*               (2) The priority class of a connection is reset to FTPc_PRIO_NORMAL by FTPc_Open().
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  FTPc_PrioSet (FTPc_CONN   *p_conn,
+                           CPU_INT08U   prio)
+{
+    CPU_SR_ALLOC();
+
+
+    if (prio >= FTPc_PRIO_NBR) {
+        return (DEF_FAIL);
+    }
+
+    CPU_CRITICAL_ENTER();
+    if (p_conn->SchedXferEn == DEF_YES) {                       /* See Note #1.                                         */
+        FTPc_SchedXferCtr[p_conn->Prio]--;
+        FTPc_SchedXferCtr[prio]++;
+    }
+    p_conn->Prio = prio;
+    CPU_CRITICAL_EXIT();
+
+    return (DEF_OK);
+}
+#endif
+
+
+#if (FTPc_CFG_STAT_EN == DEF_ENABLED)
+/*
+*********************************************************************************************************
+*                                            FTPc_StatGet()
+*
+* Description : Get the statistics of the last operation performed on an FTP connection.
+*
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
+*
+*               p_stat      Pointer to variable that will receive the statistics.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) Statistics are reset at the beginning of FTPc_Open() & of each file transfer. A
+*                   timestamp that is 0 denotes a phase that was not reached by the operation.
+*********************************************************************************************************
+*/
+
+void  FTPc_StatGet (FTPc_CONN  *p_conn,
+                    FTPc_STAT  *p_stat)
+{
+    Mem_Copy(p_stat, &p_conn->Stat, sizeof(FTPc_STAT));
+}
+#endif
+
+
+#if (FTPc_CFG_TRACE_BUF_EN == DEF_ENABLED)
+/*
+*********************************************************************************************************
+*                                            FTPc_TraceRd()
+*
+* Description : Read the records of the trace buffer that were written since a previous read.
+*
+* Argument(s) : p_ix            Pointer to read cursor, i.e. the index of the next record to read. The
+*                               cursor MUST be initialized to 0 & is updated by this function.
+*
+*               p_rec_tbl       Pointer to table that will receive the trace records.
+*
+*               rec_nbr_max     Maximum number of records to read.
+*
+* Return(s)   : Number of trace records read.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) Records that were overwritten since the previous read are skipped; the gap can be
+*                   detected from the Seq field of the records.
+*
+*               (2) Reading stops at the first record that is still being written by another task. The
+*                   sequence number of each record is checked again once the record is copied, so that a
+*                   record overwritten during the copy is discarded rather than returned torn.
+*
+*               (3) Memory barriers keep the copy of the record between the two reads of its sequence
+*                   number (see 'ftp-c.h  FTPc TRACE BUFFER  Note #4' & FTPc_TraceWr() Note #1).
+*********************************************************************************************************
+*/
+
+CPU_SIZE_T  FTPc_TraceRd (CPU_INT32U      *p_ix,
+                          FTPc_TRACE_REC  *p_rec_tbl,
+                          CPU_SIZE_T       rec_nbr_max)
+{
+    FTPc_TRACE_REC  *p_rec;
+    CPU_INT32U       ix_wr;
+    CPU_INT32U       ix_rd;
+    CPU_SIZE_T       rec_nbr;
+    CPU_SR_ALLOC();
+
+
+    CPU_CRITICAL_ENTER();
+    ix_wr = FTPc_TraceBuf.Ix;
+    CPU_CRITICAL_EXIT();
+
+    ix_rd = *p_ix;
+    if ((ix_wr - ix_rd) > FTPc_CFG_TRACE_BUF_NBR_EVT) {         /* See Note #1.                                         */
+        ix_rd = ix_wr - FTPc_CFG_TRACE_BUF_NBR_EVT;
+    }
+
+    rec_nbr = 0u;
+    while ((ix_rd   != ix_wr      ) &&
+           (rec_nbr <  rec_nbr_max)) {
+        p_rec = &FTPc_TraceBuf.Tbl[ix_rd & (FTPc_CFG_TRACE_BUF_NBR_EVT - 1u)];
+        if (p_rec->Seq != (CPU_INT16U)ix_rd) {                  /* See Note #2.                                         */
+            break;
+        }
+        FTPc_TRACE_MB();                                        /* See Note #3.                                         */
+        Mem_Copy(&p_rec_tbl[rec_nbr], p_rec, sizeof(FTPc_TRACE_REC));
+        FTPc_TRACE_MB();
+        if (p_rec->Seq != (CPU_INT16U)ix_rd) {                  /* Overwritten during copy (see Note #2).               */
+            break;
+        }
+        ix_rd++;
+        rec_nbr++;
+    }
+
+   *p_ix = ix_rd;
+
+    return (rec_nbr);
+}
+#endif
+
+
+#if (FTPc_CFG_HIST_EN == DEF_ENABLED)
+/*
+*********************************************************************************************************
+*                                            FTPc_HistGet()
+*
+* Description : Get a snapshot of the latency & throughput histograms of all connections.
+*
+* Argument(s) : p_hist      Pointer to variable that will receive the histograms.
+*
+*               reset       DEF_YES, to clear the histograms once copied.
+*                           DEF_NO,  otherwise.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) Each histogram is copied & cleared in its own critical section so that no sample is
+*                   lost between the snapshot & the reset, without masking interrupts for the copy of
+*                   all the histograms.
+*********************************************************************************************************
+*/
+
+void  FTPc_HistGet (FTPc_HIST    *p_hist,
+                    CPU_BOOLEAN   reset)
+{
+    CPU_INT08U  cmd_code;
+    CPU_SR_ALLOC();
+
+
+    for (cmd_code = 0u; cmd_code < FTP_CMD_MAX; cmd_code++) {   /* See Note #1.                                         */
+        CPU_CRITICAL_ENTER();
+        Mem_Copy(p_hist->CmdLat[cmd_code], FTPc_Hist.CmdLat[cmd_code], sizeof(FTPc_Hist.CmdLat[cmd_code]));
+        if (reset == DEF_YES) {
+            Mem_Clr(FTPc_Hist.CmdLat[cmd_code], sizeof(FTPc_Hist.CmdLat[cmd_code]));
+        }
+        CPU_CRITICAL_EXIT();
+    }
+
+    CPU_CRITICAL_ENTER();
+    Mem_Copy(p_hist->ConnLat, FTPc_Hist.ConnLat, sizeof(FTPc_Hist.ConnLat));
+    if (reset == DEF_YES) {
+        Mem_Clr(FTPc_Hist.ConnLat, sizeof(FTPc_Hist.ConnLat));
+    }
+    CPU_CRITICAL_EXIT();
+
+    CPU_CRITICAL_ENTER();
+    Mem_Copy(p_hist->XferRate, FTPc_Hist.XferRate, sizeof(FTPc_Hist.XferRate));
+    if (reset == DEF_YES) {
+        Mem_Clr(FTPc_Hist.XferRate, sizeof(FTPc_Hist.XferRate));
+    }
+    CPU_CRITICAL_EXIT();
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FTPc_HistBktValGet()
+*
+* Description : Get the lowest sample value counted by a histogram bucket.
+*
+* Argument(s) : bkt_ix      Index of the histogram bucket.
+*
+* Return(s)   : Lowest sample value of the bucket,   if bucket index is valid;
+*               DEF_INT_32U_MAX_VAL,                 otherwise.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) See 'ftp-c.h  FTPc HISTOGRAMS DATA TYPE  Note #2'.
+*********************************************************************************************************
+*/
+
+CPU_INT32U  FTPc_HistBktValGet (CPU_INT08U  bkt_ix)
+{
+    CPU_INT08U  msb;
+    CPU_INT32U  val;
+
+
+    if (bkt_ix >= FTPc_HIST_NBR_BKT) {
+        return (DEF_INT_32U_MAX_VAL);
+    }
+
+    if (bkt_ix < 2u) {
+        return ((CPU_INT32U)bkt_ix);
+    }
+
+    msb = bkt_ix / 2u;
+    val = DEF_BIT(msb);
+    if ((bkt_ix & 1u) != 0u) {
+        val |= DEF_BIT(msb - 1u);
+    }
+
+    return (val);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*                                         FTPc_WaitForStatus()
+*
+* Description : Receive FTP server reply after a request and analyze it to find the server status reply.
+*
+* Argument(s) : p_conn          Pointer to FTPc Connection object.
+*
+*               p_ctrl_data     Pointer to  buffer  that will receive the last line of the reply.
+*
+*               ctrl_data_len   Size of the buffer  that will receive the last line of the reply.
+*
+*               p_err           Pointer to variable that will receive the return error code from NetSock_RxData().
+*
+* Return(s)   : FTP server status code   if no error;
+*               0                        otherwise.
+*
+* Caller(s)   : FTPc_Open(),
+*               FTPc_Close(),
+*               FTPc_RecvBufChain(),
+*               FTPc_SendBufVect(),
+*               FTPc_RecvFile(),
+*               FTPc_SendFileSrc(),
+*               FTPc_RecvBlkDev(),
+*               FTPc_WorkDirGet(),
+*               FTPc_RemoteOpBatch(),
+*               FTPc_FileInfoGet().
+*
+* Note(s)     : (1) The reply is processed one line at a time from p_conn->Buf. Only the octets of the
+*                   reply are consumed; any data that follows the last line of the reply is left in
+*                   p_conn->Buf for a later call to this function.
+*
+*                   (a) Section 5.4 of RFC 959 titled "SEQUENCING OF COMMANDS AND REPLIES" states the
+*                       following in its second paragraph:
+*
+*                      "Certain commands require a second reply for which the user should also wait.
+*                       These replies may, for example, report on the progress or completion of file
+*                       transfer or the closing of the data connection. They are secondary replies to
+*                       file transfer commands."
+*
+*                       Such secondary replies may be received in the same segment as the first reply.
+*
+*               (2) A reply line that does not fit in p_conn->Buf is decoded from its first octets then
+*                   discarded up to its terminating line feed. This bounds the memory required by the
+*                   client regardless of the length of the server's welcome message.
+*
+*               (3) The total amount of reply data received is limited to CtrlRxMaxReplyLength octets.
+*
+*               (4) A reply that is not received, i.e. whose data does not arrive within CtrlRxMaxTimout_ms
+*                   (see FTPc_RxReply() Note #1) or that is cut by a socket error, MAY still arrive later,
+*                   in place of the reply to the next command. The control connection is then out of
+*                   sync; p_conn->CtrlFail is set & the connection MUST be closed.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  FTPc_WaitForStatus (FTPc_CONN   *p_conn,
+                                        CPU_CHAR    *p_ctrl_data,
+                                        CPU_INT16U   ctrl_data_len,
+                                        NET_ERR     *p_err)
+{
+    const  FTPc_CFG     *p_cfg;
+           CPU_CHAR     *p_buf;
+           CPU_INT16U    buf_len;
+           CPU_INT16U    line_len;
+           CPU_INT16U    multi_code;
+           CPU_INT16U    line_code;
+           CPU_INT32U    reply_code;
+           CPU_INT32U    rx_reply_tot_len;
+           CPU_INT32S    rx_reply_pkt_len;
+           CPU_BOOLEAN   line_last;
+           CPU_BOOLEAN   line_skip;
+
+
+    p_cfg            =  p_conn->CfgPtr;
+    p_buf            = (CPU_CHAR *)&p_conn->Buf[0u];
+    buf_len          =  sizeof(p_conn->Buf);
+    reply_code       =  0u;
+    multi_code       =  0u;
+    line_code        =  0u;
+    rx_reply_tot_len =  0u;
+    line_last        =  DEF_NO;
+    line_skip        =  DEF_NO;
+   *p_err            =  NET_SOCK_ERR_NONE;
+
+    NetSock_CfgTimeoutRxQ_Set(p_conn->SockID, p_cfg->CtrlRxMaxTimout_ms, p_err);
+    while (reply_code == 0u) {
+        line_len = 0u;                                          /* Search for end of current line.                      */
+        while ((line_len          <  p_conn->BufLen) &&
+               (p_buf[line_len]  != FTP_ASCII_LF   )) {
+            line_len++;
+        }
+
+        if (line_len < p_conn->BufLen) {                        /* ----------------- COMPLETE LINE RX'D --------------- */
+            line_len++;
+            if (line_skip == DEF_NO) {
+                line_last = FTPc_ReplyLineParse(p_buf, line_len, &multi_code, &line_code);
+                if (line_last == DEF_YES) {
+                    FTPc_ReplyLineCopy(p_buf, line_len, p_ctrl_data, ctrl_data_len);
+                }
+            }
+            FTPc_TRACE_INFO(("FTPc RX: %.*s", (int)line_len, p_buf));
+
+            p_conn->BufLen -= line_len;                         /* Consume line (see Note #1).                          */
+            Mem_Move(p_buf, p_buf + line_len, p_conn->BufLen);
+
+            line_skip = DEF_NO;
+            if (line_last == DEF_YES) {
+                reply_code = line_code;
+            }
+
+        } else if (p_conn->BufLen >= buf_len) {                 /* ------------- LINE LONGER THAN BUFFER -------------- */
+            if (line_skip == DEF_NO) {                          /* See Note #2.                                         */
+                line_last = FTPc_ReplyLineParse(p_buf, buf_len, &multi_code, &line_code);
+                if (line_last == DEF_YES) {
+                    FTPc_ReplyLineCopy(p_buf, buf_len, p_ctrl_data, ctrl_data_len);
+                }
+                line_skip = DEF_YES;
+            }
+            FTPc_TRACE_INFO(("FTPc RX: %.*s", (int)buf_len, p_buf));
+            p_conn->BufLen = 0u;
+
+        } else {                                                /* ------------------ RX MORE DATA -------------------- */
+            if (rx_reply_tot_len >= p_cfg->CtrlRxMaxReplyLength) {
+                NetSock_CfgRxQ_Size(p_conn->SockID, 0u, p_err); /* See Note #3.                                         */
+               *p_err = NET_SOCK_ERR_RX_Q_CLOSED;
+                p_conn->CtrlFail = DEF_YES;                     /* See Note #4.                                         */
+                return (0u);
+            }
+
+            rx_reply_pkt_len = FTPc_RxReply(p_conn,
+                                            p_buf   + p_conn->BufLen,
+                                            buf_len - p_conn->BufLen,
+                                            p_err);
+            if (rx_reply_pkt_len <= 0) {
+                p_conn->CtrlFail = DEF_YES;                     /* See Note #4.                                         */
+                return (0u);
+            }
+
+            p_conn->BufLen   += (CPU_INT16U)rx_reply_pkt_len;
+            rx_reply_tot_len +=             rx_reply_pkt_len;
+        }
+    }
+
+    NetSock_CfgTimeoutRxQ_Set(p_conn->SockID, NET_TMR_TIME_INFINITE, p_err);
+    FTPc_TRACE_EVT(FTPc_TRACE_EVT_CTRL_REPLY, reply_code, p_conn->SockID);
+    FTPc_HIST_CMD_END(p_conn);
+
+    return (reply_code);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        FTPc_ReplyLineParse()
+*
+* Description : Decode the reply code of a server reply line.
+*
+* Argument(s) : p_line          Pointer to the beginning of the reply line.
+*
+*               line_len        Number of octets of the line available in p_line.
+*
+*               p_multi_code    Pointer to variable holding the code of the multiline reply in progress :
+*
+*                                   0,                          if no multiline reply is in progress.
+*                                   Reply code,                 otherwise.
+*
+*               p_code          Pointer to variable that will receive the reply code of the last line.
+*
+* Return(s)   : DEF_YES, if line is the last line of the reply.
+*               DEF_NO,  otherwise.
+*
+* Caller(s)   : FTPc_WaitForStatus().
+*
+* Note(s)     : (1) RFC 959, section 4.2 states that a multiline reply begins with the reply code
+*                   immediately followed by a hyphen & ends with a line beginning with the same code
+*                   followed by a space. Lines in between are text & MUST be ignored.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FTPc_ReplyLineParse (CPU_CHAR    *p_line,
+                                          CPU_INT16U   line_len,
+                                          CPU_INT16U  *p_multi_code,
+                                          CPU_INT16U  *p_code)
+{
+    CPU_INT16U  code;
+    CPU_INT08U  ix;
+
+
+    if (line_len <= FTP_REPLY_CODE_LEN) {
+        return (DEF_NO);
+    }
+
+    code = 0u;
+    for (ix = 0u; ix < FTP_REPLY_CODE_LEN; ix++) {
+        if ((p_line[ix] < '0') ||
+            (p_line[ix] > '9')) {
+            return (DEF_NO);                                    /* Text line of a multiline reply.                      */
+        }
+        code = (code * 10u) + (CPU_INT16U)(p_line[ix] - '0');
+    }
+
+    if (*p_multi_code == 0u) {
+        if (p_line[FTP_REPLY_CODE_LEN] == FTP_REPLY_CODE_MULTI_LINE_INDICATOR) {
+           *p_multi_code = code;                                /* First line of multiline reply (see Note #1).         */
+            return (DEF_NO);
+        }
+    } else if ((code                          != *p_multi_code                     ) ||
+               (p_line[FTP_REPLY_CODE_LEN]   ==  FTP_REPLY_CODE_MULTI_LINE_INDICATOR)) {
+        return (DEF_NO);
+    }
+
+   *p_code = code;
+
+    return (DEF_YES);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FTPc_ReplyLineCopy()
+*
+* Description : Copy a reply line without its end-of-line delimiter to the caller's buffer.
+*
+* Argument(s) : p_line          Pointer to the beginning of the reply line.
+*
+*               line_len        Number of octets of the line available in p_line.
+*
+*               p_dest          Pointer to destination buffer, DEF_NULL if the line is not required.
+*
+*               dest_len        Size of destination buffer.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : FTPc_WaitForStatus().
+*
+* Note(s)     : (1) The copied line is always NULL-terminated & truncated if required.
+*********************************************************************************************************
+*/
+
+static  void  FTPc_ReplyLineCopy (CPU_CHAR    *p_line,
+                                  CPU_INT16U   line_len,
+                                  CPU_CHAR    *p_dest,
+                                  CPU_INT16U   dest_len)
+{
+    if ((p_dest   == DEF_NULL) ||
+        (dest_len == 0u)) {
+        return;
+    }
+
+    while ((line_len                > 0u          ) &&
+          ((p_line[line_len - 1u] == FTP_ASCII_LF) ||
+           (p_line[line_len - 1u] == FTP_ASCII_CR))) {
+        line_len--;
+    }
+
+    if (line_len > (dest_len - 1u)) {                           /* See Note #1.                                         */
+        line_len = dest_len - 1u;
+    }
+
+    Mem_Copy(p_dest, p_line, line_len);
+    p_dest[line_len] = (CPU_CHAR)'\0';
+}
+
+
+/*
+*********************************************************************************************************
+*                                             FTPc_RxReply()
+*
+* Description : Receive reply data.
+*
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
+*
+*               p_data      Pointer to  buffer  that will receive data.
+*
+*               data_len    Size of the buffer  that will receive data.
+*
+*               p_err       Pointer to variable that will receive the return error code from NetSock_RxData().
+*
+* Return(s)   : Number of positive data octets received, if NO errors;
+*               0                                        otherwise.
+*
+* Caller(s)   : FTPc_WaitForStatus().
+*
+* Note(s)     : (1) The receive timeout of the control socket is set to CtrlRxMaxTimout_ms by the caller;
+*                   an empty receive queue therefore means that no reply data was received within the
+*                   timeout, which fails the reception (see FTPc_WaitForStatus() Note #4).
+*
+*               (2) Other transitory receive errors are retried every CtrlRxMaxDly_ms, until the retry
+*                   delays add up to CtrlRxMaxTimout_ms.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32S  FTPc_RxReply (FTPc_CONN   *p_conn,
+                                  CPU_CHAR    *p_data,
+                                  CPU_INT16U   data_len,
+                                  NET_ERR     *p_err)
+{
+    const  FTPc_CFG     *p_cfg;
+           CPU_INT32S    pkt_size;
+           CPU_INT32U    stall_ms;
+           CPU_BOOLEAN   rx_done;
+
+
+    p_cfg = p_conn->CfgPtr;
+
+    pkt_size = 0;
+    stall_ms = 0u;
+    rx_done  = DEF_NO;
+
+    while (rx_done != DEF_YES) {
+
+        pkt_size = FTPc_SOCK_RX_DATA(p_conn->SockID,
+                                     p_data,
+                                     data_len,
+                                     NET_SOCK_FLAG_NONE,
+                                     p_err);
+        FTPc_STAT_INC(p_conn, RxCallCtr);
+        switch (*p_err) {
+            case NET_SOCK_ERR_NONE:
+                 rx_done = DEF_YES;
+                 break;
+
+
+            case NET_SOCK_ERR_RX_Q_EMPTY:                       /* See Note #1.                                         */
+                 pkt_size = 0;
+                 rx_done  = DEF_YES;
+                 FTPc_TRACE_DBG(("FTPc reply timeout, line #%u.\n", (unsigned int)__LINE__));
+                 break;
+
+
+            case NET_ERR_RX:                                    /* If transitory rx err(s), ...                         */
+            case NET_ERR_INIT_INCOMPLETE:
+            case NET_ERR_FAULT_LOCK_ACQUIRE:
+                 FTPc_STAT_INC(p_conn, ErrTransientCtr);
+                 FTPc_TRACE_DBG(("FTPc NetSock_RxData(): error #%u, line #%u.\n", (unsigned int)*p_err, (unsigned int)__LINE__));
+                 if (stall_ms >= p_cfg->CtrlRxMaxTimout_ms) {   /* See Note #2.                                         */
+                     pkt_size = 0;
+                     rx_done  = DEF_YES;
+                     break;
+                 }
+                 KAL_Dly(p_cfg->CtrlRxMaxDly_ms);
+                 stall_ms += p_cfg->CtrlRxMaxDly_ms;
+                 break;
+
+
+            default:
+                 pkt_size = 0;
+                 rx_done  = DEF_YES;
+                 FTPc_TRACE_DBG(("FTPc NetSock_RxData() failed: error #%u, line #%u.\n", (unsigned int)*p_err, (unsigned int)__LINE__));
+                 break;
+        }
+    }
+
+    return (pkt_size);
+}
+
+
+/*
+*********************************************************************************************************
+*                                               FTPc_Tx()
+*
+* Description : Transmit data to TCP socket, handling transient errors and incomplete buffer transmit.
+*
+* Argument(s) : p_conn          Pointer to FTPc Connection object.
+*
+*               sock_id         Socket descriptor/handle identifier of socket to transmit application data.
+*
+*               p_data          Pointer to application data to transmit.
+*
+*               data_len        Length  of data to transmit (in octets).
+*
+*               timeout_ms      Transmit timeout value per attempt/retry :
+*
+*                                   0,                          if current configured timeout value desired
+*                                                                   [or NO timeout for datagram sockets
+*                                                                   (see Note #5)].
+*                                   NET_TMR_TIME_INFINITE,      if infinite (i.e. NO timeout) value desired.
+*                                   In number of milliseconds,  otherwise.
+*
+*               retry_max       Maximum number of consecutive socket transmit retries (see Note #3).
+*
+*               time_dly_ms     Maximum transitory transmit delay value, in milliseconds (see Note #2).
+*
+*               p_err           Pointer to variable that will receive the return error code from NetSock_TxData().
+*
+* Return(s)   : DEF_FAIL        transmission failed.
+*               DEF_OK          transmission successful.
+*
+* Caller(s)   : FTPc_Open(),
+*               FTPc_Close(),
+*               FTPc_RecvBufChain(),
+*               FTPc_SendBufVect(),
+*               FTPc_RecvFile(),
+*               FTPc_SendFileSrc(),
+*               FTPc_RecvBlkDev().
+*
+* Note(s)     : (1) The round-trip latency of a command is measured from its transmission on the control
+*                   socket to the reception of its reply by FTPc_WaitForStatus().
+*
+*               (2) Transitory transmit errors & zero-length transmits are retried with an exponential
+*                   backoff. The delay starts at FTPc_TX_DLY_MIN_MS, doubles on each consecutive retry
+*                   up to time_dly_ms & halves on each partial transmit, so that a congested link
+*                   neither sleeps whole time_dly_ms periods while its transmit queue frees up in a few
+*                   milliseconds, nor spins on short delays. The backoff level is local to each call
+*                   since the control & data sockets of a connection are transmitted on independently.
+*
+*               (3) Transmission fails once the retry delays of the call add up to (retry_max *
+*                   time_dly_ms) milliseconds, i.e. the longest stall tolerated by a fixed delay retry
+*                   strategy, regardless of the number of retries. Partial transmits do NOT restart
+*                   this budget, so that a peer that only accepts a few octets at a time cannot hold
+*                   the call indefinitely.
+*
+*               (4) The transmit timeout configured on the socket before the call is restored on every
+*                   return, successful or not.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FTPc_Tx (FTPc_CONN   *p_conn,
+                              CPU_INT32S   sock_id,
+                              CPU_CHAR    *p_data,
+                              CPU_INT16U   data_len,
+                              CPU_INT32U   timeout_ms,
+                              CPU_INT16U   retry_max,
+                              CPU_INT32U   time_dly_ms,
+                              NET_ERR     *p_err)
+{
+    CPU_CHAR     *tx_buf;
+    CPU_INT16S    tx_buf_len;
+    CPU_INT16S    tx_len;
+    CPU_INT16S    tx_len_tot;
+    CPU_INT32U    timeout_ms_cfgd;
+    CPU_INT32U    stall_ms;
+    CPU_INT32U    stall_max_ms;
+    CPU_INT32U    dly_ms;
+    CPU_INT32U    dly_ms_next;
+    CPU_BOOLEAN   tx_dly;
+    CPU_BOOLEAN   rtn_code;
+    NET_ERR       err;
+
+
+    timeout_ms_cfgd = 0u;
+    if (timeout_ms != 0) {
+        timeout_ms_cfgd = NetSock_CfgTimeoutTxQ_Get_ms(sock_id, p_err);
+        NetSock_CfgTimeoutTxQ_Set(sock_id, timeout_ms, p_err);
+    }
+
+    if (sock_id == p_conn->SockID) {                            /* Time ctrl cmd (see Note #1).                         */
+        FTPc_HIST_CMD_START(p_conn, p_data, data_len);
+    }
+
+    tx_len_tot   = 0;
+    stall_ms     = 0u;
+    stall_max_ms = (CPU_INT32U)retry_max * time_dly_ms;         /* See Note #3.                                         */
+    dly_ms_next  = FTPc_TX_DLY_MIN_MS;                          /* See Note #2.                                         */
+    tx_dly       = DEF_NO;
+    while (tx_len_tot < data_len) {                             /* While tx tot len < buf len ...                       */
+
+        if (tx_dly == DEF_YES) {                                /* Dly tx, if req'd (see Note #2).                      */
+            if (stall_ms >= stall_max_ms) {                     /* ... unless stall budget exhausted.                   */
+                if (*p_err == NET_SOCK_ERR_NONE) {
+                   *p_err = NET_ERR_TX;
+                }
+                rtn_code = DEF_FAIL;
+                goto exit;
+            }
+            dly_ms       = DEF_MIN(dly_ms_next, time_dly_ms);
+            dly_ms       = DEF_MIN(dly_ms, stall_max_ms - stall_ms);
+            dly_ms       = DEF_MAX(dly_ms, FTPc_TX_DLY_MIN_MS);
+            FTPc_STAT_INC(p_conn, TxRetryCtr);
+            KAL_Dly(dly_ms);
+            stall_ms    += dly_ms;
+            dly_ms_next  = DEF_MIN(dly_ms * 2u, time_dly_ms);
+        }
+
+        tx_buf     = p_data   + tx_len_tot;
+        tx_buf_len = data_len - tx_len_tot;
+        tx_len     = FTPc_SOCK_TX_DATA(sock_id,                 /* ... tx data.                                         */
+                                       tx_buf,
+                                       tx_buf_len,
+                                       NET_SOCK_FLAG_NONE,
+                                       p_err);
+        FTPc_STAT_INC(p_conn, TxCallCtr);
+        switch (*p_err) {
+            case NET_SOCK_ERR_NONE:
+                 if (tx_len > 0) {                              /* If          tx len > 0, ...                          */
+                     tx_len_tot  += tx_len;                     /* ... inc tot tx len.                                  */
+                     tx_dly       = DEF_NO;
+                     dly_ms_next /= 2u;                         /* Stall budget NOT restarted (see Note #3).            */
+                 } else {                                       /* Else dly next tx.                                    */
+                     tx_dly       = DEF_YES;
+                 }
+                 break;
+
+
+            case NET_ERR_TX:                                    /* If transitory tx err(s), ...                         */
+            case NET_ERR_INIT_INCOMPLETE:
+            case NET_SOCK_ERR_PORT_NBR_NONE_AVAIL:
+            case NET_CONN_ERR_NONE_AVAIL:
+#ifdef  NET_IPv4_MODULE_EN
+            case NET_IPv4_ERR_ADDR_NONE_AVAIL:
+            case NET_IPv4_ERR_ADDR_CFG_IN_PROGRESS:
+#endif
+#ifdef  NET_IPv6_MODULE_EN
+            case NET_IPv6_ERR_ADDR_NONE_AVAIL:
+            case NET_IPv6_ERR_ADDR_CFG_IN_PROGRESS:
+#endif
+            case NET_ERR_FAULT_LOCK_ACQUIRE:
+                 FTPc_STAT_INC(p_conn, ErrTransientCtr);
+                 tx_dly = DEF_YES;                              /* ... dly next tx.                                     */
+                 break;
+
+
+            default:
+                 rtn_code = DEF_FAIL;
+                 goto exit;
+        }
+    }
+
+    rtn_code = (*p_err == NET_SOCK_ERR_NONE) ? DEF_OK : DEF_FAIL;
+
+exit:
+    if (timeout_ms != 0) {                                      /* Restore cfg'd timeout (see Note #4).                 */
+        NetSock_CfgTimeoutTxQ_Set(sock_id, timeout_ms_cfgd, &err);
+    }
+
+    return (rtn_code);
+}
+
+
+/*
+*********************************************************************************************************
+*                                             FTPc_Conn()
+*
+* Description : Connect a data socket in PASV or EPSV mode.
+*
+* Argument(s) : p_conn          Pointer to FTPc Connection object.
+*
+*               p_ctrl_buf      Pointer to buffer that contain the result of status message.
+*
+*               ctrl_buf_size   Size of control buffer.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FTPc_ERR_NONE                   Data Connection was successful.
+*                               FTPc_ERR_FAULT                  Faulted because of invalid IP address family.
+*                               FTPc_ERR_CMD_LEN                Command longer than control buffer.
+*                               FTPc_ERR_TX_CMD                 Sending Command failed.
+*                               FTPc_ERR_RX_CMD_RESP_INVALID    Receiving Command response failed.
+*                               FTPc_ERR_CONN_FAIL              Connection failed.
+*
+* Return(s)   : Data socket ID,   if no error.
+*               NET_SOCK_ID_NONE, otherwise.
+*
+* Caller(s)   : FTPc_RecvBufChain(),
+*               FTPc_SendBufVect(),
+*               FTPc_RecvFile(),
+*               FTPc_SendFileSrc(),
+*               FTPc_RecvBlkDev().
+*
+* Note(s)     : (1) In batch mode, the passive address & port of the data connection may already have been
+*                   received at the end of the previous transfer (see FTPc_XferEnd() Note #1). Since the
+*                   server MAY have stopped listening on that port while the application was idle, a
+*                   failed connection to a prefetched port is retried once on a new passive port.
+*
+*               (2) Secure data connections resume the TLS session of the control connection when
+*                   available (see FTPc_ConnSecureResume()).
+*
+*               (3) On a secure connection, the PROT command is only sent when the protection level of
+*                   the transfer differs from the level set on the server (see FTPc_ProtSet()).
+*********************************************************************************************************
+*/
+
+static  NET_SOCK_ID  FTPc_Conn (FTPc_CONN   *p_conn,
+                                CPU_CHAR    *p_ctrl_buf,
+                                CPU_INT16U   ctrl_buf_size,
+                                FTPc_ERR    *p_err)
+{
+#ifdef  NET_IPv6_MODULE_EN
+           NET_SOCK_ADDR_IPv6       *p_sock_addr_ipv6;
+#endif
+    const  FTPc_CFG                 *p_cfg;
+           NET_APP_SOCK_SECURE_CFG  *p_secure = DEF_NULL;
+           CPU_INT08U               *p_addr;
+           NET_SOCK_ID               sock_dtp_id;
+           CPU_BOOLEAN               pasv_prefetch;
+           CPU_BOOLEAN               rtn_code;
+           NET_ERR                   err;
+
+
+    p_cfg = p_conn->CfgPtr;
+
+#ifdef  NET_SECURE_MODULE_EN
+    if (p_conn->SecureCfgPtr != DEF_NULL) {                     /* Set protection level of the xfer (see Note #3).      */
+        rtn_code = FTPc_ProtReq(p_conn, p_conn->Prot, p_ctrl_buf, ctrl_buf_size, p_err);
+        if (rtn_code == DEF_FAIL) {
+            return (NET_SOCK_ID_NONE);
+        }
+    }
+#endif
+
+    pasv_prefetch = p_conn->PasvRdy;
+
+conn_retry:
+    if (p_conn->PasvRdy == DEF_NO) {                            /* See Note #1.                                         */
+        rtn_code = FTPc_PasvReq(p_conn, p_ctrl_buf, ctrl_buf_size, p_err);
+        if (rtn_code == DEF_FAIL) {
+            return (NET_SOCK_ID_NONE);
+        }
+
+        rtn_code = FTPc_PasvReply(p_conn, p_ctrl_buf, ctrl_buf_size, p_err);
+        if (rtn_code == DEF_FAIL) {
+            return (NET_SOCK_ID_NONE);
+        }
+    }
+
+    p_conn->PasvRdy = DEF_NO;                                   /* Passive port can only be used once.                  */
+    FTPc_STAT_TS(p_conn, TS_Pasv);
+
+    switch (p_conn->SockAddrFamily) {
+#ifdef  NET_IPv4_MODULE_EN
+        case NET_IP_ADDR_FAMILY_IPv4:
+             p_addr           = (CPU_INT08U *)&p_conn->PasvAddrIPv4;
+             break;
+#endif
+
+#ifdef  NET_IPv6_MODULE_EN
+        case NET_IP_ADDR_FAMILY_IPv6:
+             p_sock_addr_ipv6 = (NET_SOCK_ADDR_IPv6 *)&p_conn->SockAddr;
+             p_addr           = (CPU_INT08U         *)&p_sock_addr_ipv6->Addr;
+             break;
+#endif
+
+        default:
+            *p_err = FTPc_ERR_FAULT;
+             return (NET_SOCK_ID_NONE);
+    }
+
+#ifdef  NET_SECURE_MODULE_EN
+    if (p_conn->Prot == FTP_PROT_PRIVATE) {
+        p_secure = (NET_APP_SOCK_SECURE_CFG *)p_conn->SecureCfgPtr;
+    }
+    if ((p_secure                 != DEF_NULL) &&               /* See Note #2.                                         */
+        (p_conn->SecureSessionPtr != DEF_NULL)) {
+        sock_dtp_id = FTPc_ConnSecureResume(p_conn, p_addr, &err);
+    } else
+#endif
+    {
+        sock_dtp_id = NetApp_ClientStreamOpen( p_addr,
+                                               p_conn->SockAddrFamily,
+                                               p_conn->PasvPort,
+                                               DEF_NULL,
+                                               p_secure,
+                                               p_cfg->DTP_ConnMaxTimout_ms,
+                                              &err);
+    }
+    switch (err) {
+        case NET_APP_ERR_NONE:
+             FTPc_STAT_TS(p_conn, TS_DataConn);
+             FTPc_HIST_XFER_START(p_conn);
+             FTPc_TRACE_EVT(FTPc_TRACE_EVT_DTP_OPEN, sock_dtp_id, p_conn->PasvPort);
+             break;
+
+        case NET_APP_ERR_CONN_FAIL:
+             if (pasv_prefetch == DEF_YES) {                    /* Retry on a new passive port (see Note #1).           */
+                 FTPc_TRACE_DBG(("FTPc prefetched passive port %u refused, line #%u.\n", (unsigned int)p_conn->PasvPort, (unsigned int)__LINE__));
+                 pasv_prefetch = DEF_NO;
+                 goto conn_retry;
+             }
+            *p_err = FTPc_ERR_CONN_FAIL;
+             return (NET_SOCK_ID_NONE);
+
+        case NET_ERR_IF_LINK_DOWN:
+            *p_err = FTPc_ERR_CONN_FAIL;
+             return (NET_SOCK_ID_NONE);
+
+        default:
+           *p_err = FTPc_ERR_FAULT;
+            return (NET_SOCK_ID_NONE);
+    }
+
+    FTPc_SockOptApply(sock_dtp_id, p_cfg->DTP_SockOptPtr);
+
+    FTPc_SCHED_XFER_START(p_conn);                              /* Xfer ended by FTPc_XferEnd().                        */
+
+   *p_err = FTPc_ERR_NONE;
+
+    return (sock_dtp_id);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            FTPc_PasvReq()
+*
+* Description : Send a PASV or EPSV command, according to the address family of the control connection.
+*
+* Argument(s) : p_conn          Pointer to FTPc Connection object.
+*
+*               p_ctrl_buf      Pointer to buffer used to format the command.
+*
+*               ctrl_buf_size   Size of control buffer.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FTPc_ERR_NONE                   Command sent.
+*                               FTPc_ERR_FAULT                  Faulted because of invalid IP address family.
+*                               FTPc_ERR_CMD_LEN                Command longer than control buffer.
+*                               FTPc_ERR_TX_CMD                 Sending Command failed.
+*
+* Return(s)   : DEF_FAIL        transmission failed.
+*               DEF_OK          transmission successful.
+*
+* Caller(s)   : FTPc_Conn(),
+*               FTPc_XferEnd().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FTPc_PasvReq (FTPc_CONN   *p_conn,
+                                   CPU_CHAR    *p_ctrl_buf,
+                                   CPU_INT16U   ctrl_buf_size,
+                                   FTPc_ERR    *p_err)
+{
+    CPU_INT08U  cmd;
+
+
+    switch (p_conn->SockAddrFamily) {
+#ifdef  NET_IPv4_MODULE_EN
+        case NET_IP_ADDR_FAMILY_IPv4:
+             cmd = FTP_CMD_PASV;
+             break;
+#endif
+
+        case NET_IP_ADDR_FAMILY_IPv6:
+             cmd = FTP_CMD_EPSV;
+             break;
+
+        default:
+            *p_err = FTPc_ERR_FAULT;
+             return (DEF_FAIL);
+    }
+
+    return (FTPc_CmdTx(p_conn, cmd, DEF_NULL, p_ctrl_buf, ctrl_buf_size, p_err));
+}
+
+
+/*
+*********************************************************************************************************
+*                                           FTPc_PasvReply()
+*
+* Description : Receive the reply to a PASV or EPSV command & save the passive address & port announced
+*               by the server.
+*
+* Argument(s) : p_conn          Pointer to FTPc Connection object.
+*
+*               p_ctrl_buf      Pointer to buffer that will receive the status message.
+*
+*               ctrl_buf_size   Size of control buffer.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FTPc_ERR_NONE                   Passive address & port received.
+*                               FTPc_ERR_FAULT                  Faulted because of invalid IP address family.
+*                               FTPc_ERR_RX_CMD_RESP_INVALID    Receiving Command response failed.
+*
+* Return(s)   : DEF_FAIL        reception failed.
+*               DEF_OK          reception successful.
+*
+* Caller(s)   : FTPc_Conn(),
+*               FTPc_XferEnd().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FTPc_PasvReply (FTPc_CONN   *p_conn,
+                                     CPU_CHAR    *p_ctrl_buf,
+                                     CPU_INT16U   ctrl_buf_size,
+                                     FTPc_ERR    *p_err)
+{
+#ifdef  NET_IPv4_MODULE_EN
+    NET_IPv4_ADDR  server_ipv4;
+    CPU_INT32S     tmp_val;
+#endif
+    CPU_INT16U     server_port;
+    CPU_CHAR      *tmp_buf;
+    CPU_INT32U     reply_code;
+    NET_ERR        err;
+
+
+                                                                /* Receive status line.                                 */
+    reply_code = FTPc_WaitForStatus(p_conn, p_ctrl_buf, ctrl_buf_size, &err);
+
+
+    switch (p_conn->SockAddrFamily) {
+#ifdef  NET_IPv4_MODULE_EN
+        case NET_IP_ADDR_FAMILY_IPv4:
+             if (reply_code != FTP_REPLY_CODE_ENTERPASVMODE) {
+                *p_err = FTPc_ERR_RX_CMD_RESP_INVALID;
+                 return (DEF_FAIL);
+             }
+
+             server_ipv4  = 0;
+             server_port  = 0;
+             tmp_buf      = Str_Char(p_ctrl_buf, '(');
+             if (tmp_buf == (CPU_CHAR *)0) {
+                *p_err = FTPc_ERR_RX_CMD_RESP_INVALID;
+                 return (DEF_FAIL);
+             }
+             tmp_buf++;
+
+             tmp_val      = Str_ParseNbr_Int32U(tmp_buf, &tmp_buf, 10);  /* Get IP Address MSB.                                  */
+             tmp_buf++;
+             server_ipv4 += tmp_val << 24;
+
+             tmp_val      = Str_ParseNbr_Int32U(tmp_buf, &tmp_buf, 10);
+             tmp_buf++;
+             server_ipv4 += tmp_val << 16;
+
+             tmp_val      = Str_ParseNbr_Int32U(tmp_buf, &tmp_buf, 10);
+             tmp_buf++;
+             server_ipv4 += tmp_val << 8;
+
+             tmp_val      = Str_ParseNbr_Int32U(tmp_buf, &tmp_buf, 10);  /* Get IP Address LSB.                                  */
+             tmp_buf++;
+             server_ipv4 += tmp_val << 0;
+
+             tmp_val      = Str_ParseNbr_Int32U(tmp_buf, &tmp_buf, 10);  /* Get IP Port MSB.                                     */
+             tmp_buf++;
+             server_port += tmp_val << 8;
+
+             tmp_val      = Str_ParseNbr_Int32U(tmp_buf, &tmp_buf, 10);  /* Get IP Port LSB.                                     */
+             tmp_buf++;
+             server_port += tmp_val << 0;
+
+             p_conn->PasvAddrIPv4 = server_ipv4;
+             break;
+#endif
+
+#ifdef  NET_IPv6_MODULE_EN
+        case NET_IP_ADDR_FAMILY_IPv6:
+             if (reply_code != FTP_REPLY_CODE_ENTEREXTPASVMODE) {
+                *p_err = FTPc_ERR_RX_CMD_RESP_INVALID;
+                 return (DEF_FAIL);
+             }
+
+             tmp_buf          =  Str_Str(p_ctrl_buf, FTP_ASCII_EPSV_PREFIX);
+             if (tmp_buf == (CPU_CHAR *)0) {
+                *p_err = FTPc_ERR_RX_CMD_RESP_INVALID;
+                 return (DEF_FAIL);
+             }
+             tmp_buf          =  tmp_buf + Str_Len(FTP_ASCII_EPSV_PREFIX);
+             server_port      =  Str_ParseNbr_Int32U(tmp_buf, &tmp_buf, 10);
+             break;
+#endif
+
+        default:
+            *p_err = FTPc_ERR_FAULT;
+             return (DEF_FAIL);
+    }
+
+    p_conn->PasvPort = server_port;
+    p_conn->PasvRdy  = DEF_YES;
+
+   *p_err = FTPc_ERR_NONE;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                             FTPc_CmdTx()
+*
+* Description : Transmit a command on the control connection.
+*
+* Argument(s) : p_conn          Pointer to FTPc Connection object.
+*
+*               cmd             Command code (FTP_CMD_*).
+*
+*               p_arg           Pointer to command argument, or DEF_NULL if the command has no argument.
+*
+*               p_ctrl_buf      Pointer to control buffer.
+*
+*               ctrl_buf_size   Size of control buffer.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FTPc_ERR_NONE                   Command sent.
+*                               FTPc_ERR_CMD_LEN                Command longer than control buffer.
+*                               FTPc_ERR_TX_CMD                 Sending Command failed.
+*
+* Return(s)   : DEF_FAIL        transmission failed.
+*               DEF_OK          transmission successful.
+*
+* Caller(s)   : FTPc_Open(),
+*               FTPc_Close(),
+*               FTPc_RecvBufChain(),
+*               FTPc_SendBufVect(),
+*               FTPc_RecvFile(),
+*               FTPc_SendFileSrc(),
+*               FTPc_RecvBlkDev(),
+*               FTPc_WorkDirGet(),
+*               FTPc_RemoteOpBatch(),
+*               FTPc_FileInfoGet(),
+*               FTPc_PasvReq(),
+*               FTPc_TypeReq(),
+*               FTPc_ProtReq(),
+*               FTPc_XferEnd().
+*
+* Note(s)     : (1) Str_FmtPrint() returns the length the formatted command would have had, even when
+*                   it was truncated to fit the control buffer. A truncated command would be sent
+*                   without its terminating CRLF & leave the server waiting for the rest of the line,
+*                   so a command that does not fit in the control buffer is never sent.
+*
+*               (2) A command partially sent leaves the control connection out of sync; p_conn->CtrlFail
+*                   is set & the connection MUST be closed.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FTPc_CmdTx (FTPc_CONN   *p_conn,
+                                 CPU_INT08U   cmd,
+                                 CPU_CHAR    *p_arg,
+                                 CPU_CHAR    *p_ctrl_buf,
+                                 CPU_INT16U   ctrl_buf_size,
+                                 FTPc_ERR    *p_err)
+{
+    const  FTPc_CFG     *p_cfg;
+           CPU_INT32U    buf_size;
+           CPU_BOOLEAN   rtn_code;
+           NET_ERR       err;
+
+
+    p_cfg = p_conn->CfgPtr;
+
+    if (p_arg != DEF_NULL) {
+        buf_size = Str_FmtPrint((char *)p_ctrl_buf, ctrl_buf_size, "%s %s\r\n", FTPc_Cmd[cmd].CmdStr, p_arg);
+    } else {
+        buf_size = Str_FmtPrint((char *)p_ctrl_buf, ctrl_buf_size, "%s\r\n", FTPc_Cmd[cmd].CmdStr);
+    }
+    if (buf_size >= ctrl_buf_size) {                            /* See Note #1.                                         */
+        FTPc_TRACE_INFO(("FTPc TX: %s command too long.\n", FTPc_Cmd[cmd].CmdStr));
+       *p_err = FTPc_ERR_CMD_LEN;
+        return (DEF_FAIL);
+    }
+
+    rtn_code = FTPc_Tx(p_conn,
+                       p_conn->SockID,
+                       p_ctrl_buf,
+                       buf_size,
+                       p_cfg->CtrlTxMaxTimout_ms,
+                       p_cfg->CtrlTxMaxRetry,
+                       p_cfg->CtrlTxMaxDly_ms,
+                      &err);
+    if (cmd == FTP_CMD_PASS) {
+        FTPc_TRACE_INFO(("FTPc TX: PASS ******"));
+    } else {
+        FTPc_TRACE_INFO(("FTPc TX: %s", p_ctrl_buf));
+    }
+    if (rtn_code == DEF_FAIL) {
+        p_conn->CtrlFail = DEF_YES;                             /* See Note #2.                                         */
+       *p_err            = FTPc_ERR_TX_CMD;
+        return (DEF_FAIL);
+    }
+
+   *p_err = FTPc_ERR_NONE;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        FTPc_RemoteOpAbort()
+*
+* Description : Set the result of the operations left pending by an aborted batch of remote operations.
+*
+* Argument(s) : p_op_tbl    Pointer to table of remote operations.
+*
+*               op_ix_rx    Index of the first operation whose reply was not received.
+*
+*               op_ix_tx    Index of the first operation whose commands were not sent.
+*
+*               op_nbr      Number of remote operations in table.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : FTPc_RemoteOpBatch().
+*
+* Note(s)     : (1) The outcome of an operation whose commands were sent is unknown since its reply was
+*                   not received (see FTPc_RemoteOpBatch() Note #6); it is reported as a reply failure.
+*                   Operations whose commands were not sent are reported as not performed.
+*********************************************************************************************************
+*/
+
+static  void  FTPc_RemoteOpAbort (FTPc_REMOTE_OP  *p_op_tbl,
+                                  CPU_SIZE_T       op_ix_rx,
+                                  CPU_SIZE_T       op_ix_tx,
+                                  CPU_SIZE_T       op_nbr)
+{
+    CPU_SIZE_T  op_ix;
+
+
+    for (op_ix = op_ix_rx; op_ix < op_nbr; op_ix++) {
+        if (p_op_tbl[op_ix].Err == FTPc_ERR_NONE) {             /* See Note #1.                                         */
+            p_op_tbl[op_ix].Err  = (op_ix < op_ix_tx) ? FTPc_ERR_RX_CMD_RESP_FAIL
+                                                      : FTPc_ERR_TX_CMD;
+        }
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                            FTPc_TypeReq()
+*
+* Description : Set the data type of the following transfer on the FTP server.
+*
+* Argument(s) : p_conn          Pointer to FTPc Connection object.
+*
+*               type            Data type to set (see FTPc_TypeSet()).
+*
+*               p_ctrl_buf      Pointer to control buffer.
+*
+*               ctrl_buf_size   Size of control buffer.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FTPc_ERR_NONE                   Data type set.
+*                               FTPc_ERR_CMD_LEN                Command longer than control buffer.
+*                               FTPc_ERR_TX_CMD                 Sending Command failed.
+*                               FTPc_ERR_RX_CMD_RESP_FAIL       Receiving Command response failed.
+*
+* Return(s)   : DEF_FAIL        data type not set.
+*               DEF_OK          data type set.
+*
+* Caller(s)   : FTPc_RecvBufChain(),
+*               FTPc_SendBufVect(),
+*               FTPc_RecvFile(),
+*               FTPc_SendFileSrc(),
+*               FTPc_RecvBlkDev(),
+*               FTPc_FileInfoGet().
+*
+* Note(s)     : (1) The data type accepted by the server is kept in the connection, so that the TYPE
+*                   command is only sent when the data type changes during the session.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FTPc_TypeReq (FTPc_CONN   *p_conn,
+                                   CPU_CHAR     type,
+                                   CPU_CHAR    *p_ctrl_buf,
+                                   CPU_INT16U   ctrl_buf_size,
+                                   FTPc_ERR    *p_err)
+{
+    CPU_CHAR      arg[2];
+    CPU_INT32U    reply_code;
+    CPU_BOOLEAN   rtn_code;
+    NET_ERR       err;
+
+
+    if (p_conn->TypeCur == type) {                              /* See Note #1.                                         */
+        return (DEF_OK);
+    }
+
+    p_conn->TypeCur = FTPc_TYPE_UNKNOWN;
+    arg[0]          = type;
+    arg[1]          = (CPU_CHAR)'\0';
+                                                                /* Send TYPE command.                                   */
+    rtn_code = FTPc_CmdTx(p_conn, FTP_CMD_TYPE, arg, p_ctrl_buf, ctrl_buf_size, p_err);
+    if (rtn_code == DEF_FAIL) {
+        return (DEF_FAIL);
+    }
+                                                                /* Receive status line.                                 */
+    reply_code = FTPc_WaitForStatus(p_conn, 0, 0, &err);
+    if (reply_code != FTP_REPLY_CODE_OKAY) {
+       *p_err = FTPc_ERR_RX_CMD_RESP_FAIL;
+        return (DEF_FAIL);
+    }
+
+    p_conn->TypeCur = type;
+
+    return (DEF_OK);
+}
+
+
+#ifdef  NET_SECURE_MODULE_EN
+/*
+*********************************************************************************************************
+*                                            FTPc_ProtReq()
+*
+* Description : Set the data protection level on the server, if not already set.
+*
+* Argument(s) : p_conn          Pointer to FTPc Connection object.
+*
+*               prot            Data protection level to set (see FTPc_ProtSet()).
+*
+*               p_ctrl_buf      Pointer to control buffer.
+*
+*               ctrl_buf_size   Size of control buffer.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FTPc_ERR_NONE                   Protection level set.
+*                               FTPc_ERR_CMD_LEN                Command longer than control buffer.
+*                               FTPc_ERR_TX_CMD                 Sending Command failed.
+*                               FTPc_ERR_RX_CMD_RESP_FAIL       Receiving Command response failed.
+*
+* Return(s)   : DEF_FAIL        protection level not set.
+*               DEF_OK          protection level set.
+*
+* Caller(s)   : FTPc_Open(),
+*               FTPc_Conn().
+*
+* Note(s)     : (1) The protection level accepted by the server is kept in the connection, so that the
+*                   PROT command is only sent when the level changes during the session.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FTPc_ProtReq (FTPc_CONN   *p_conn,
+                                   CPU_CHAR     prot,
+                                   CPU_CHAR    *p_ctrl_buf,
+                                   CPU_INT16U   ctrl_buf_size,
+                                   FTPc_ERR    *p_err)
+{
+    CPU_CHAR      arg[2];
+    CPU_INT32U    reply_code;
+    CPU_BOOLEAN   rtn_code;
+    NET_ERR       err;
+
+
+    if (p_conn->ProtCur == prot) {                              /* See Note #1.                                         */
+        return (DEF_OK);
+    }
+
+    p_conn->ProtCur = FTPc_PROT_UNKNOWN;
+    arg[0]          = prot;
+    arg[1]          = (CPU_CHAR)'\0';
+                                                                /* Send PROT command.                                   */
+    rtn_code = FTPc_CmdTx(p_conn, FTP_CMD_PROT, arg, p_ctrl_buf, ctrl_buf_size, p_err);
+    if (rtn_code == DEF_FAIL) {
+        return (DEF_FAIL);
+    }
+                                                                /* Receive status line.                                 */
+    reply_code = FTPc_WaitForStatus(p_conn, 0, 0, &err);
+    if (reply_code != FTP_REPLY_CODE_OKAY) {
+       *p_err = FTPc_ERR_RX_CMD_RESP_FAIL;
+        return (DEF_FAIL);
+    }
+
+    p_conn->ProtCur = prot;
+
+    return (DEF_OK);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                            FTPc_XferEnd()
+*
+* Description : Close the data connection of a transfer & receive the transfer completion reply.
+*
+* Argument(s) : p_conn          Pointer to FTPc Connection object.
+*
+*               sock_dtp_id     Data socket ID.
+*
+*               xfer_open       DEF_YES, if the server accepted the transfer command (see Note #3);
+*                               DEF_NO,  otherwise.
+*
+*               p_ctrl_buf      Pointer to control buffer.
+*
+*               ctrl_buf_size   Size of control buffer.
+*
+*               p_err       Pointer to variable that holds the error code of the transfer & that will
+*                           receive the return error code from this function :
+*
+*                               FTPc_ERR_NONE                   Transfer completed successfully.
+*                               FTPc_ERR_RX_CMD_RESP_FAIL       Receiving Command response failed.
+*
+* Return(s)   : DEF_FAIL        transfer failed.
+*               DEF_OK          transfer successful.
+*
+* Caller(s)   : FTPc_RecvBufChain(),
+*               FTPc_SendBufVect(),
+*               FTPc_RecvFile(),
+*               FTPc_SendFileSrc(),
+*               FTPc_RecvBlkDev().
+*
+* Note(s)     : (1) In batch mode, the PASV or EPSV command of the next transfer is sent before the
+*                   completion reply of the current transfer is received. The passive reply immediately
+*                   follows the completion reply, so the round-trip of the next data connection setup
+*                   overlaps the completion of the current transfer. If the passive reply is invalid,
+*                   the next transfer simply requests a new passive port.
+*
+*               (2) The latency of a pipelined passive command is not recorded since its reply is queued
+*                   behind the completion reply of the current transfer.
+*
+*               (3) A transfer that fails after the server accepted the transfer command is aborted with
+*                   the ABOR command before the data connection is closed, so that the server does not
+*                   complete the transfer. A NOOP command is then sent & replies are received up to the
+*                   NOOP reply. Whichever replies the server sends to the transfer & to the ABOR command,
+*                   the control connection is thus left in sync for the next command. The error code of
+*                   the transfer is returned unchanged.
+*
+*               (4) If the control connection cannot be resynchronized, p_conn->CtrlFail is set (see
+*                   FTPc_WaitForStatus() Note #4).
+*
+*               (5) The passive reply of the next transfer is not waited for if the completion reply
+*                   of the current transfer was not received or the control connection is out of sync,
+*                   since it would only stall the failure for another reply timeout. The transfer then
+*                   fails & the connection MUST be closed.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FTPc_XferEnd (FTPc_CONN    *p_conn,
+                                   NET_SOCK_ID   sock_dtp_id,
+                                   CPU_BOOLEAN   xfer_open,
+                                   CPU_CHAR     *p_ctrl_buf,
+                                   CPU_INT16U    ctrl_buf_size,
+                                   FTPc_ERR     *p_err)
+{
+    CPU_INT32U   reply_code;
+    CPU_INT08U   reply_cnt;
+    CPU_BOOLEAN  pasv_req;
+    CPU_BOOLEAN  abort_tx;
+    FTPc_ERR     abort_err;
+    FTPc_ERR     pasv_err;
+    NET_ERR      err;
+
+
+    abort_tx = DEF_FAIL;
+    if ((*p_err    != FTPc_ERR_NONE) &&                         /* Abort xfer before closing data conn (see Note #3).   */
+        (xfer_open == DEF_YES)) {
+        abort_tx = FTPc_CmdTx(p_conn, FTP_CMD_ABOR, DEF_NULL, p_ctrl_buf, ctrl_buf_size, &abort_err);
+    }
+                                                                /* Close socket.                                        */
+    NetSock_Close(sock_dtp_id, &err);
+    FTPc_TRACE_INFO(("FTPc CLOSE DTP socket.\n"));
+    FTPc_TRACE_EVT(FTPc_TRACE_EVT_DTP_CLOSE, sock_dtp_id, *p_err);
+    FTPc_SCHED_XFER_END(p_conn);
+
+    if (*p_err != FTPc_ERR_NONE) {
+        if (xfer_open == DEF_NO) {
+            return (DEF_FAIL);
+        }
+
+        if (abort_tx == DEF_OK) {
+            abort_tx = FTPc_CmdTx(p_conn, FTP_CMD_NOOP, DEF_NULL, p_ctrl_buf, ctrl_buf_size, &abort_err);
+        }
+
+        reply_code = 0u;
+        reply_cnt  = 0u;
+        while ((abort_tx   == DEF_OK                   ) &&     /* Rx replies up to NOOP reply (see Note #3).           */
+               (reply_code != FTP_REPLY_CODE_OKAY      ) &&
+               (reply_cnt  <  FTPc_XFER_ABORT_REPLY_MAX)) {
+            reply_code = FTPc_WaitForStatus(p_conn, 0, 0, &err);
+            if (reply_code == 0u) {
+                break;
+            }
+            reply_cnt++;
+        }
+
+        if (reply_code != FTP_REPLY_CODE_OKAY) {                /* See Note #4.                                         */
+            FTPc_TRACE_DBG(("FTPc control connection out of sync, line #%u.\n", (unsigned int)__LINE__));
+            p_conn->CtrlFail = DEF_YES;
+        }
+
+        return (DEF_FAIL);
+    }
+
+    pasv_req = DEF_FAIL;
+    if (p_conn->BatchEn == DEF_ENABLED) {                       /* See Note #1.                                         */
+        pasv_req = FTPc_PasvReq(p_conn, p_ctrl_buf, ctrl_buf_size, &pasv_err);
+        FTPc_HIST_CMD_CLR(p_conn);                              /* See Note #2.                                         */
+    }
+                                                                /* Receive status line.                                 */
+    reply_code = FTPc_WaitForStatus(p_conn, 0, 0, &err);
+
+    if ((pasv_req         == DEF_OK) &&                         /* Skip pasv reply if ctrl conn lost (see Note #5).     */
+        (reply_code       != 0u    ) &&
+        (p_conn->CtrlFail == DEF_NO)) {
+       (void)FTPc_PasvReply(p_conn, p_ctrl_buf, ctrl_buf_size, &pasv_err);
+    }
+
+    if (reply_code != FTP_REPLY_CODE_CLOSINGSUCCESS) {
+       *p_err = FTPc_ERR_RX_CMD_RESP_FAIL;
+        return (DEF_FAIL);
+    }
+    FTPc_STAT_TS(p_conn, TS_End);
+    FTPc_HIST_XFER_END(p_conn);
+
+   *p_err = FTPc_ERR_NONE;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FTPc_SockOptApply()
+*
+* Description : Apply socket tuning options to a control or data socket.
+*
+* Argument(s) : sock_id     Socket ID.
+*
+*               p_opt       Pointer to socket options (see Note #1).
+*
+* Return(s)   : none.
+*
+* Caller(s)   : FTPc_Open(),
+*               FTPc_Conn().
+*
+* Note(s)     : (1) A DEF_NULL options pointer, a null queue size or a FTPc_SOCK_OPT_DFLT option leaves the
+*                   network stack's default configuration unchanged.
+*
+*               (2) The TCP receive window advertised to the server is bounded by the size of the receive
+*                   queue.
+*
+*               (3) Options are tuning hints only; an option that cannot be applied is traced & the
+*                   socket keeps the network stack's default for that option.
+*********************************************************************************************************
+*/
+
+static  void  FTPc_SockOptApply (      NET_SOCK_ID     sock_id,
+                                 const FTPc_SOCK_OPT  *p_opt)
+{
+    CPU_INT32S  opt_val;
+    NET_ERR     err;
+
+
+    if (p_opt == DEF_NULL) {                                    /* See Note #1.                                         */
+        return;
+    }
+
+    if (p_opt->RxQ_Size != 0u) {                                /* See Note #2.                                         */
+       (void)NetSock_CfgRxQ_Size(sock_id, (NET_SOCK_DATA_SIZE)p_opt->RxQ_Size, &err);
+        if (err != NET_SOCK_ERR_NONE) {                         /* See Note #3.                                         */
+            FTPc_TRACE_DBG(("FTPc NetSock_CfgRxQ_Size() failed: error #%u, line #%u.\n", (unsigned int)err, (unsigned int)__LINE__));
+        }
+    }
+
+    if (p_opt->TxQ_Size != 0u) {
+       (void)NetSock_CfgTxQ_Size(sock_id, (NET_SOCK_DATA_SIZE)p_opt->TxQ_Size, &err);
+        if (err != NET_SOCK_ERR_NONE) {
+            FTPc_TRACE_DBG(("FTPc NetSock_CfgTxQ_Size() failed: error #%u, line #%u.\n", (unsigned int)err, (unsigned int)__LINE__));
+        }
+    }
+
+    if (p_opt->NoDelay != FTPc_SOCK_OPT_DFLT) {
+        opt_val = (p_opt->NoDelay == DEF_ENABLED) ? 1 : 0;
+       (void)NetSock_OptSet(sock_id,
+                            NET_SOCK_PROTOCOL_TCP,
+                            NET_SOCK_OPT_TCP_NO_DELAY,
+                           &opt_val,
+                            sizeof(opt_val),
+                           &err);
+        if (err != NET_SOCK_ERR_NONE) {
+            FTPc_TRACE_DBG(("FTPc NetSock_OptSet() failed: error #%u, line #%u.\n", (unsigned int)err, (unsigned int)__LINE__));
+        }
+    }
+
+    if (p_opt->KeepAlive != FTPc_SOCK_OPT_DFLT) {
+        opt_val = (p_opt->KeepAlive == DEF_ENABLED) ? 1 : 0;
+       (void)NetSock_OptSet(sock_id,
+                            NET_SOCK_PROTOCOL_SOCK,
+                            NET_SOCK_OPT_SOCK_KEEP_ALIVE,
+                           &opt_val,
+                            sizeof(opt_val),
+                           &err);
+        if (err != NET_SOCK_ERR_NONE) {
+            FTPc_TRACE_DBG(("FTPc NetSock_OptSet() failed: error #%u, line #%u.\n", (unsigned int)err, (unsigned int)__LINE__));
+        }
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                            FTPc_DTP_Rx()
+*
+* Description : Receive data from the data socket & detect the end of the transfer.
+*
+* Argument(s) : p_conn          Pointer to FTPc Connection object.
+*
+*               sock_dtp_id     Data socket ID.
+*
+*               p_buf           Pointer to buffer that will receive the data.
+*
+*               buf_len         Size of buffer.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FTPc_ERR_NONE                   Data received or end-of-file.
+*                               FTPc_ERR_RX_TIMEOUT             No data received for DTP_RxMaxTimout_ms.
+*                               FTPc_ERR_CONN_FAIL              Data socket failed.
+*
+* Return(s)   : Number of octets received,  if any;
+*               0,                          on end-of-file or error.
+*
+* Caller(s)   : FTPc_RecvBufChain(),
+*               FTPc_RecvFile(),
+*               FTPc_RecvBlkDev().
+*
+* Note(s)     : (1) The end of the transfer is detected from the first of the following conditions :
+*
+*                   (a) The server closed the data connection.
+*                   (b) A reply to the transfer command was received on the control connection & the
+*                       data socket then remained empty for FTPc_DTP_RX_REPLY_POLL_NBR poll periods.
+*                       Since the reply MAY overtake data still in flight on the data connection, the
+*                       data socket is still read for a few poll periods rather than only until its
+*                       first empty poll period. Data delayed on the data connection by more than
+*                       these few poll periods after the reply is NOT received; the server normally
+*                       closes the data connection well before then, which ends the transfer at once
+*                       (see Note #1a). The reply is left in p_conn->Buf for FTPc_WaitForStatus().
+*
+*                   Transfers of known size are also ended by the caller once all octets are received.
+*
+*               (2) The data socket receive timeout MUST be set to FTPc_DTP_RX_POLL_MS by the caller so
+*                   that the control connection is checked while waiting for data.
+*
+*               (3) A data connection that remains silent for DTP_RxMaxTimout_ms without any reply on the
+*                   control connection is reported as an error rather than as the end of the file.
+*
+*               (4) Delaying the next read lets the receive window of the data connection fill up, which
+*                   slows the server down to the rate limit.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32S  FTPc_DTP_Rx (FTPc_CONN   *p_conn,
+                                 NET_SOCK_ID  sock_dtp_id,
+                                 CPU_CHAR    *p_buf,
+                                 CPU_INT16U   buf_len,
+                                 FTPc_ERR    *p_err)
+{
+    CPU_INT32S   rx_len;
+    CPU_INT32U   stall_ms;
+    CPU_BOOLEAN  reply_rdy;
+    NET_ERR      err;
+
+
+    stall_ms  = 0u;
+    reply_rdy = DEF_NO;
+    while (DEF_TRUE) {
+        rx_len = FTPc_SOCK_RX_DATA(sock_dtp_id, p_buf, buf_len, NET_SOCK_FLAG_NONE, &err);
+        FTPc_STAT_INC(p_conn, RxCallCtr);
+        switch (err) {
+            case NET_SOCK_ERR_NONE:
+                 if (rx_len > 0) {
+                                                                /* See Note #4.                                         */
+                     FTPc_DTP_THROTTLE(p_conn, (CPU_INT32U)rx_len);
+                     FTPc_SCHED_YIELD(p_conn);
+                    *p_err = FTPc_ERR_NONE;
+                     return (rx_len);
+                 }
+                *p_err = FTPc_ERR_NONE;                         /* See Note #1a.                                        */
+                 return (0);
+
+
+            case NET_SOCK_ERR_RX_Q_CLOSED:                      /* See Note #1a.                                        */
+                *p_err = FTPc_ERR_NONE;
+                 return (0);
+
+
+            case NET_SOCK_ERR_RX_Q_EMPTY:                       /* Poll period elapsed (see Note #2).                   */
+                 if (reply_rdy == DEF_NO) {
+                     reply_rdy = FTPc_CtrlReplyRdy(p_conn);
+                     if (reply_rdy == DEF_YES) {                /* Restart stall with reply grace period.               */
+                         stall_ms = 0u;
+                     }
+                 }
+
+                 stall_ms += FTPc_DTP_RX_POLL_MS;
+                 if (reply_rdy == DEF_YES) {                    /* See Note #1b.                                        */
+                     if (stall_ms < (FTPc_DTP_RX_REPLY_POLL_NBR * FTPc_DTP_RX_POLL_MS)) {
+                         break;
+                     }
+                    *p_err = FTPc_ERR_NONE;
+                     return (0);
+                 }
+                 if (stall_ms < p_conn->CfgPtr->DTP_RxMaxTimout_ms) {
+                     break;
+                 }
+                 FTPc_TRACE_DBG(("FTPc data connection stalled, line #%u.\n", (unsigned int)__LINE__));
+                *p_err = FTPc_ERR_RX_TIMEOUT;                   /* See Note #3.                                         */
+                 return (0);
+
+
+            default:
+                 FTPc_TRACE_DBG(("FTPc NetSock_RxData() failed: error #%u, line #%u.\n", (unsigned int)err, (unsigned int)__LINE__));
+                 FTPc_TRACE_EVT(FTPc_TRACE_EVT_DTP_RX_ERR, err, sock_dtp_id);
+                *p_err = FTPc_ERR_CONN_FAIL;
+                 return (0);
+        }
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FTPc_CtrlReplyRdy()
+*
+* Description : Check, without blocking, whether a reply line was received on the control connection.
+*
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
+*
+* Return(s)   : DEF_YES, if a complete reply line is pending in p_conn->Buf or the control connection is
+*                        closed;
+*               DEF_NO,  otherwise.
+*
+* Caller(s)   : FTPc_DTP_Rx().
+*
+* Note(s)     : (1) Received data is appended to p_conn->Buf & consumed later by FTPc_WaitForStatus().
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FTPc_CtrlReplyRdy (FTPc_CONN  *p_conn)
+{
+    CPU_INT32S  rx_len;
+    CPU_INT16U  ix;
+    NET_ERR     err;
+
+
+    if (p_conn->BufLen < sizeof(p_conn->Buf)) {                 /* See Note #1.                                         */
+        rx_len = FTPc_SOCK_RX_DATA(p_conn->SockID,
+                                  &p_conn->Buf[p_conn->BufLen],
+                                   sizeof(p_conn->Buf) - p_conn->BufLen,
+                                   NET_SOCK_FLAG_RX_NO_BLOCK,
+                                  &err);
+        FTPc_STAT_INC(p_conn, RxCallCtr);
+        switch (err) {
+            case NET_SOCK_ERR_NONE:
+                 if (rx_len > 0) {
+                     p_conn->BufLen += (CPU_INT16U)rx_len;
+                 }
+                 break;
+
+
+            case NET_SOCK_ERR_RX_Q_EMPTY:
+                 break;
+
+
+            default:                                            /* Ctrl conn closed or failed.                          */
+                 return (DEF_YES);
+        }
+    }
+
+    for (ix = 0u; ix < p_conn->BufLen; ix++) {
+        if (p_conn->Buf[ix] == FTP_ASCII_LF) {
+            return (DEF_YES);
+        }
+    }
+
+    return (DEF_NO);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           FTPc_AsciiFind()
+*
+* Description : Find the first occurrence of a character in a data buffer.
+*
+* Argument(s) : p_buf       Pointer to data buffer.
+*
+*               buf_len     Length of data buffer.
+*
+*               c           Character to find.
+*
+* Return(s)   : Index of the first occurrence of the character,  if found;
+*               buf_len,                                          otherwise.
+*
+* Caller(s)   : FTPc_AsciiRxConv(),
+*               FTPc_AsciiTxConv().
+*
+* Note(s)     : (1) Aligned data is scanned one CPU word at a time. A word contains the character if the
+*                   word XOR'd with the character replicated in each octet has a null octet, which is
+*                   detected without branching per octet :
+*
+*                       (w - 0x01010101) & ~w & 0x80808080 != 0
+*
+*                   This portable word-at-a-time scan is used instead of CPU specific SIMD instructions.
+*
+*               (2) Words are read only once the index is aligned on a word boundary, & through
+*                   FTPc_WORD_RD() so that reading octet data as a word does not break the strict
+*                   aliasing rules : a may_alias word type is used with GCC-compatible compilers & the
+*                   word is copied with Mem_Copy() otherwise.
+*/
+
+static  CPU_SIZE_T  FTPc_AsciiFind (const  CPU_CHAR    *p_buf,
+                                           CPU_SIZE_T   buf_len,
+                                           CPU_CHAR     c)
+{
+    CPU_SIZE_T  ix;
+    CPU_INT32U  pattern;
+    CPU_INT32U  word;
+
+
+    ix = 0u;
+    while ((ix < buf_len) &&                                    /* Scan octets up to word boundary (see Note #2).       */
+          (((CPU_ADDR)&p_buf[ix] % sizeof(CPU_INT32U)) != 0u)) {
+        if (p_buf[ix] == c) {
+            return (ix);
+        }
+        ix++;
+    }
+
+    pattern = (CPU_INT32U)(CPU_INT08U)c * 0x01010101u;
+    while ((ix + sizeof(CPU_INT32U)) <= buf_len) {              /* Scan words (see Note #1).                            */
+        FTPc_WORD_RD(&word, &p_buf[ix]);                        /* See Note #2.                                         */
+        word ^= pattern;
+        if (((word - 0x01010101u) & ~word & 0x80808080u) != 0u) {
+            break;
+        }
+        ix += sizeof(CPU_INT32U);
+    }
+
+    while (ix < buf_len) {                                      /* Locate octet in word & scan remaining octets.        */
+        if (p_buf[ix] == c) {
+            return (ix);
+        }
+        ix++;
+    }
+
+    return (buf_len);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          FTPc_AsciiRxConv()
+*
+* Description : Convert received network ASCII data to local line endings, in place.
+*
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
+*
+*               p_buf       Pointer to received data.
+*
+*               buf_len     Length of received data.
+*
+* Return(s)   : Length of converted data.
+*
+* Caller(s)   : FTPc_RecvBufChain(),
+*               FTPc_RecvFile().
+*
+* Note(s)     : (1) CR octets immediately followed by LF are removed; other CR octets are kept.
+*
+*               (2) A CR that ends the data may be followed by a LF in the next received chunk. It is
+*                   then excluded from the converted data, copied right after it & p_conn->AsciiCR is
+*                   set. The caller MUST place it in front of the next chunk, or append it to the data
+*                   if no more data is received.
+*********************************************************************************************************
+*/
+
+static  CPU_SIZE_T  FTPc_AsciiRxConv (FTPc_CONN   *p_conn,
+                                      CPU_CHAR    *p_buf,
+                                      CPU_SIZE_T   buf_len)
+{
+    CPU_SIZE_T  rd_ix;
+    CPU_SIZE_T  wr_ix;
+    CPU_SIZE_T  run_len;
+
+
+    rd_ix           = 0u;
+    wr_ix           = 0u;
+    p_conn->AsciiCR = DEF_NO;
+    while (rd_ix < buf_len) {
+        run_len = FTPc_AsciiFind(&p_buf[rd_ix], buf_len - rd_ix, FTP_ASCII_CR);
+        if (wr_ix != rd_ix) {
+            Mem_Move(&p_buf[wr_ix], &p_buf[rd_ix], run_len);
+        }
+        wr_ix += run_len;
+        rd_ix += run_len;
+        if (rd_ix >= buf_len) {
+            break;
+        }
+
+        if ((rd_ix + 1u) == buf_len) {                          /* See Note #2.                                         */
+            p_buf[wr_ix]    = FTP_ASCII_CR;
+            p_conn->AsciiCR = DEF_YES;
+            break;
+        }
+
+        if (p_buf[rd_ix + 1u] != FTP_ASCII_LF) {                /* See Note #1.                                         */
+            p_buf[wr_ix] = FTP_ASCII_CR;
+            wr_ix++;
+        }
+        rd_ix++;
+    }
+
+    return (wr_ix);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          FTPc_AsciiTxConv()
+*
+* Description : Convert local ASCII data to network line endings.
+*
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
+*
+*               p_src       Pointer to local data.
+*
+*               src_len     Length of local data.
+*
+*               p_dest      Pointer to buffer that will receive the converted data (see Note #2).
+*
+*               dest_len    Size of destination buffer.
+*
+*               p_src_used  Pointer to variable that will receive the number of local data octets converted.
+*
+* Return(s)   : Length of converted data.
+*
+* Caller(s)   : FTPc_SendBufVect(),
+*               FTPc_SendFileSrc().
+*
+* Note(s)     : (1) LF octets that are not preceded by a CR are converted to CRLF. p_conn->AsciiCR tracks
+*                   the last octet converted so that CRLF sequences split across calls are kept intact.
+*
+*               (2) The destination buffer MAY overlap the local data if it starts at least src_len
+*                   octets before it, since each local octet is converted to at most 2 octets.
+*********************************************************************************************************
+*/
+
+static  CPU_SIZE_T  FTPc_AsciiTxConv (       FTPc_CONN   *p_conn,
+                                      const  CPU_CHAR    *p_src,
+                                             CPU_SIZE_T   src_len,
+                                             CPU_CHAR    *p_dest,
+                                             CPU_SIZE_T   dest_len,
+                                             CPU_SIZE_T  *p_src_used)
+{
+    CPU_SIZE_T  rd_ix;
+    CPU_SIZE_T  wr_ix;
+    CPU_SIZE_T  run_len;
+    CPU_SIZE_T  run_max;
+
+
+    rd_ix = 0u;
+    wr_ix = 0u;
+    while ((rd_ix < src_len ) &&
+           (wr_ix < dest_len)) {
+        run_max = DEF_MIN(src_len - rd_ix, dest_len - wr_ix);
+        run_len = FTPc_AsciiFind(&p_src[rd_ix], run_max, FTP_ASCII_LF);
+        if (run_len > 0u) {
+            Mem_Move(&p_dest[wr_ix], &p_src[rd_ix], run_len);   /* See Note #2.                                         */
+            p_conn->AsciiCR = (p_src[rd_ix + run_len - 1u] == FTP_ASCII_CR) ? DEF_YES : DEF_NO;
+            wr_ix += run_len;
+            rd_ix += run_len;
+        }
+        if (run_len >= run_max) {
+            continue;
+        }
+                                                                /* Convert LF (see Note #1).                            */
+        if (p_conn->AsciiCR == DEF_NO) {
+            if ((dest_len - wr_ix) < FTP_EOL_DELIMITER_LEN) {
+                break;
+            }
+            p_dest[wr_ix] = FTP_ASCII_CR;
+            wr_ix++;
+        }
+        p_dest[wr_ix]   = FTP_ASCII_LF;
+        wr_ix++;
+        rd_ix++;
+        p_conn->AsciiCR = DEF_NO;
+    }
+
+   *p_src_used = rd_ix;
+
+    return (wr_ix);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FTPc_FileSrcOpenFS()
+*
+* Description : Open a file of the file system for reading.
+*
+* Argument(s) : p_name      Pointer to name of the file in file system.
+*
+* Return(s)   : Pointer to file handle, if NO error(s).
+*               Pointer to NULL,        otherwise.
+*
+* Caller(s)   : FTPc_SendFileSrc(), through FTPc_FileSrcFS.
+*
+* Note(s)     : None.
+*********************************************************************************************************
+*/
+
+#if (FTPc_CFG_USE_FS == DEF_ENABLED)
+static  void  *FTPc_FileSrcOpenFS (CPU_CHAR  *p_name)
+{
+    void  *p_file;
+
+
+    p_file = NetFS_FileOpen(p_name,
+                            NET_FS_FILE_MODE_OPEN,
+                            NET_FS_FILE_ACCESS_RD);
+
+    return (p_file);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           FTPc_BlkDevWr()
+*
+* Description : Write the block buffer to a block device & erase the next sector ahead of time.
+*
+* Argument(s) : p_dev       Pointer to block device.
+*
+*               addr        Address of the block in the block device, in octets.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FTPc_ERR_NONE                   Block written.
+*                               FTPc_ERR_FILE_BUF_LEN           Block beyond the end of the block device.
+*                               FTPc_ERR_BLK_DEV_ERASE          Erase of next sector failed.
+*                               FTPc_ERR_BLK_DEV_WR             Block write failed.
+*                               FTPc_ERR_BLK_DEV_VERIFY         Block verification failed.
+*
+* Return(s)   : DEF_FAIL        write failed.
+*               DEF_OK          write successful.
+*
+* Caller(s)   : FTPc_RecvBlkDev().
+*
+* Note(s)     : (1) Each block is read back & compared with the block buffer, if the device provides a
+*                   verify function.
+*
+*               (2) The next sector is erased as soon as the first block of the current sector is
+*                   written, so that an erase operation started by the device runs while the remaining
+*                   blocks of the current sector are received from the network.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FTPc_BlkDevWr (FTPc_BLK_DEV  *p_dev,
+                                    CPU_INT32U     addr,
+                                    FTPc_ERR      *p_err)
+{
+    const  FTPc_BLK_DEV_API  *p_api;
+           CPU_INT32U         addr_next;
+           CPU_BOOLEAN        rtn_code;
+
+
+    if (addr >= p_dev->Size) {
+       *p_err = FTPc_ERR_FILE_BUF_LEN;
+        return (DEF_FAIL);
+    }
+
+    p_api    = p_dev->ApiPtr;
+    rtn_code = p_api->Wr(p_dev->DevPtr, addr, p_dev->BufPtr, p_dev->BlkSize);
+    if (rtn_code != DEF_OK) {
+       *p_err = FTPc_ERR_BLK_DEV_WR;
+        return (DEF_FAIL);
+    }
+
+    if (p_api->Verify != DEF_NULL) {                            /* See Note #1.                                         */
+        rtn_code = p_api->Verify(p_dev->DevPtr, addr, p_dev->BufPtr, p_dev->BlkSize);
+        if (rtn_code != DEF_OK) {
+           *p_err = FTPc_ERR_BLK_DEV_VERIFY;
+            return (DEF_FAIL);
+        }
+    }
+
+    addr_next = addr + p_dev->SecSize;
+    if (((addr % p_dev->SecSize) == 0u) &&                      /* Erase next sector (see Note #2).                     */
+        ( addr_next              < p_dev->Size)) {
+        rtn_code = p_api->Erase(p_dev->DevPtr, addr_next);
+        if (rtn_code != DEF_OK) {
+           *p_err = FTPc_ERR_BLK_DEV_ERASE;
+            return (DEF_FAIL);
+        }
+    }
+
+    return (DEF_OK);
+}
+
+
+#if (FTPc_CFG_META_CACHE_EN == DEF_ENABLED)
+/*
+*********************************************************************************************************
+*                                         FTPc_MetaCacheGet()
+*
+* Description : Find the valid metadata cache entry of a remote path.
+*
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
+*
+*               p_path      Pointer to name of the file in FTP server.
+*
+* Return(s)   : Pointer to cache entry, if found & not expired;
+*               Pointer to NULL,        otherwise.
+*
+* Caller(s)   : FTPc_FileInfoGet().
+*
+* Note(s)     : (1) Expired entries are freed as they are found.
+*********************************************************************************************************
+*/
+
+static  FTPc_META_ENTRY  *FTPc_MetaCacheGet (       FTPc_CONN  *p_conn,
+                                             const  CPU_CHAR   *p_path)
+{
+    FTPc_META_ENTRY  *p_entry;
+    CPU_INT32U        ts_ms;
+    CPU_INT16U        ix;
+
+
+    ts_ms = (CPU_INT32U)NetUtil_TS_Get_ms();
+    for (ix = 0u; ix < FTPc_CFG_META_CACHE_NBR_ENTRY; ix++) {
+        p_entry = &p_conn->MetaCache[ix];
+        if (p_entry->Path[0] == (CPU_CHAR)'\0') {
+            continue;
+        }
+
+        if ((ts_ms - p_entry->TS_ms) >= FTPc_CFG_META_CACHE_TTL_MS) {
+            p_entry->Path[0] = (CPU_CHAR)'\0';                  /* See Note #1.                                         */
+            continue;
+        }
+
+        if (Str_Cmp_N(p_entry->Path, p_path, FTPc_CFG_META_CACHE_PATH_LEN_MAX) == 0) {
+            return (p_entry);
+        }
+    }
+
+    return (DEF_NULL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FTPc_MetaCachePut()
+*
+* Description : Store the metadata of a remote path in the metadata cache.
+*
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
+*
+*               p_path      Pointer to name of the file in FTP server.
+*
+*               p_info      Pointer to file metadata.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : FTPc_FileInfoGet(),
+*               FTPc_FileInfoPut().
+*
+* Note(s)     : (1) Paths that do not fit in a cache entry are not cached.
+*
+*               (2) The entry of the path is replaced if present; otherwise a free entry is used, or the
+*                   oldest entry if the cache is full.
+*********************************************************************************************************
+*/
+
+static  void  FTPc_MetaCachePut (       FTPc_CONN       *p_conn,
+                                 const  CPU_CHAR        *p_path,
+                                 const  FTPc_FILE_INFO  *p_info)
+{
+    FTPc_META_ENTRY  *p_entry;
+    FTPc_META_ENTRY  *p_entry_put;
+    CPU_SIZE_T        path_len;
+    CPU_INT32U        ts_ms;
+    CPU_INT16U        ix;
+
+
+    path_len = Str_Len_N(p_path, FTPc_CFG_META_CACHE_PATH_LEN_MAX);
+    if (path_len >= FTPc_CFG_META_CACHE_PATH_LEN_MAX) {         /* See Note #1.                                         */
+        return;
+    }
+
+    ts_ms       = (CPU_INT32U)NetUtil_TS_Get_ms();
+    p_entry_put = &p_conn->MetaCache[0];
+    for (ix = 0u; ix < FTPc_CFG_META_CACHE_NBR_ENTRY; ix++) {   /* See Note #2.                                         */
+        p_entry = &p_conn->MetaCache[ix];
+        if (p_entry->Path[0] == (CPU_CHAR)'\0') {
+            p_entry_put = p_entry;
+            continue;
+        }
+        if (Str_Cmp_N(p_entry->Path, p_path, FTPc_CFG_META_CACHE_PATH_LEN_MAX) == 0) {
+            p_entry_put = p_entry;
+            break;
+        }
+        if ((p_entry_put->Path[0] != (CPU_CHAR)'\0') &&
+            ((ts_ms - p_entry->TS_ms) > (ts_ms - p_entry_put->TS_ms))) {
+            p_entry_put = p_entry;
+        }
+    }
+
+   (void)Str_Copy_N(p_entry_put->Path, p_path, FTPc_CFG_META_CACHE_PATH_LEN_MAX);
+    p_entry_put->Info  = *p_info;
+    p_entry_put->TS_ms =  ts_ms;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FTPc_MetaCacheInv()
+*
+* Description : Invalidate the metadata cache entry of a remote path.
+*
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
+*
+*               p_path      Pointer to name of the file in FTP server, or DEF_NULL to invalidate all entries.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : FTPc_Open(),
+*               FTPc_SendBufVect(),
+*               FTPc_SendFileSrc(),
+*               FTPc_RemoteOpBatch().
+*
+* Note(s)     : None.
+*********************************************************************************************************
+*/
+
+static  void  FTPc_MetaCacheInv (       FTPc_CONN  *p_conn,
+                                 const  CPU_CHAR   *p_path)
+{
+    FTPc_META_ENTRY  *p_entry;
+    CPU_INT16U        ix;
+
+
+    for (ix = 0u; ix < FTPc_CFG_META_CACHE_NBR_ENTRY; ix++) {
+        p_entry = &p_conn->MetaCache[ix];
+        if ((p_path == DEF_NULL) ||
+            (Str_Cmp_N(p_entry->Path, p_path, FTPc_CFG_META_CACHE_PATH_LEN_MAX) == 0)) {
+            p_entry->Path[0] = (CPU_CHAR)'\0';
+        }
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           FTPc_HostOpen()
+*
+* Description : Open the control connection to an FTP server.
+*
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
+*
+*               p_host      Pointer to hostname/IP address string of the server.
+*
+*               port_nbr    IP port of the server.
+*
+*               p_secure    Pointer to secure configuration, or DEF_NULL.
+*
+*               p_err       Pointer to variable that will receive the return error code from
+*                           NetApp_ClientStreamOpenByHostname() or NetApp_ClientStreamOpen().
+*
+* Return(s)   : IP address family of the connection.
+*
+* Caller(s)   : FTPc_Open().
+*
+* Note(s)     : (1) When FTPc_CFG_HOST_CACHE_EN is DEF_ENABLED, the address of each server successfully
+*                   connected to is cached for FTPc_CFG_HOST_CACHE_TTL_MS milliseconds :
+*
+*                   (a) While the cached address is valid, the server is connected to at this address,
+*                       without resolving its host name. If the connection fails, the host name is
+*                       resolved again in case the server address changed.
+*
+*                   (b) Once expired, the host name is resolved again. If either the resolution or the
+*                       connection fails, the server is connected to at its last known good address.
+*
+*               (2) The network stack does not report the lifetime of the resolved addresses; the
+*                   configured lifetime is used instead.
+*********************************************************************************************************
+*/
+
+static  NET_IP_ADDR_FAMILY  FTPc_HostOpen (FTPc_CONN                *p_conn,
+                                           CPU_CHAR                 *p_host,
+                                           NET_PORT_NBR              port_nbr,
+                                           NET_APP_SOCK_SECURE_CFG  *p_secure,
+                                           NET_ERR                  *p_err)
+{
+    const  FTPc_CFG            *p_cfg;
+#if (FTPc_CFG_HOST_CACHE_EN == DEF_ENABLED)
+           FTPc_HOST_ENTRY      entry;
+           CPU_BOOLEAN          found;
+           CPU_BOOLEAN          valid;
+#endif
+           NET_IP_ADDR_FAMILY   family;
+
+
+    p_cfg = p_conn->CfgPtr;
+
+#if (FTPc_CFG_HOST_CACHE_EN == DEF_ENABLED)
+    found = FTPc_HostCacheGet(p_host, &entry);
+    valid = DEF_NO;
+    if (found == DEF_YES) {
+        valid = (((CPU_INT32U)NetUtil_TS_Get_ms() - entry.TS_ms) < FTPc_CFG_HOST_CACHE_TTL_MS) ? DEF_YES : DEF_NO;
+    }
+
+    if (valid == DEF_YES) {                                     /* See Note #1a.                                        */
+        p_conn->SockID = NetApp_ClientStreamOpen( entry.Addr,
+                                                  entry.Family,
+                                                  port_nbr,
+                                                 &p_conn->SockAddr,
+                                                  p_secure,
+                                                  p_cfg->CtrlConnMaxTimout_ms,
+                                                  p_err);
+        if (*p_err == NET_APP_ERR_NONE) {
+            return (entry.Family);
+        }
+    }
+#endif
+
+    family = NetApp_ClientStreamOpenByHostname(&p_conn->SockID,
+                                                p_host,
+                                                port_nbr,
+                                               &p_conn->SockAddr,
+                                                p_secure,
+                                                p_cfg->CtrlConnMaxTimout_ms,
+                                                p_err);
+#if (FTPc_CFG_HOST_CACHE_EN == DEF_ENABLED)
+    if (*p_err == NET_APP_ERR_NONE) {
+        p_conn->SockAddrFamily = family;
+        FTPc_HostCachePut(p_host, p_conn);
+
+    } else if ((found == DEF_YES) &&                            /* See Note #1b.                                        */
+               (valid == DEF_NO )) {
+        p_conn->SockID = NetApp_ClientStreamOpen( entry.Addr,
+                                                  entry.Family,
+                                                  port_nbr,
+                                                 &p_conn->SockAddr,
+                                                  p_secure,
+                                                  p_cfg->CtrlConnMaxTimout_ms,
+                                                  p_err);
+        family         = entry.Family;
+    }
+#endif
+
+    return (family);
+}
+
+
+#if (FTPc_CFG_HOST_CACHE_EN == DEF_ENABLED)
+/*
+*********************************************************************************************************
+*                                         FTPc_HostCacheGet()
+*
+* Description : Get the cached address of a server.
+*
+* Argument(s) : p_host      Pointer to hostname/IP address string of the server.
+*
+*               p_entry     Pointer to variable that will receive a copy of the cache entry.
+*
+* Return(s)   : DEF_YES, if the server address is cached;
+*               DEF_NO,  otherwise.
+*
+* Caller(s)   : FTPc_HostOpen().
+*
+* Note(s)     : (1) The host cache is shared by all connections; entries are copied in a critical section.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FTPc_HostCacheGet (const  CPU_CHAR         *p_host,
+                                               FTPc_HOST_ENTRY  *p_entry)
+{
+    CPU_BOOLEAN  found;
+    CPU_INT16U   ix;
+    CPU_SR_ALLOC();
+
+
+    found = DEF_NO;
+    CPU_CRITICAL_ENTER();                                       /* See Note #1.                                         */
+    for (ix = 0u; ix < FTPc_CFG_HOST_CACHE_NBR_ENTRY; ix++) {
+        if ((FTPc_HostCache[ix].Name[0] != (CPU_CHAR)'\0') &&
+            (Str_Cmp_N(FTPc_HostCache[ix].Name, p_host, FTPc_CFG_HOST_CACHE_NAME_LEN_MAX) == 0)) {
+           *p_entry = FTPc_HostCache[ix];
+            found   = DEF_YES;
+            break;
+        }
+    }
+    CPU_CRITICAL_EXIT();
+
+    return (found);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FTPc_HostCachePut()
+*
+* Description : Cache the address of the server of a connection.
+*
+* Argument(s) : p_host      Pointer to hostname/IP address string of the server.
+*
+*               p_conn      Pointer to FTPc Connection object connected to the server.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : FTPc_HostOpen().
+*
+* Note(s)     : (1) Host names that do not fit in a cache entry are not cached.
+*
+*               (2) The entry of the host is replaced if present; otherwise a free entry is used, or the
+*                   oldest entry if the cache is full.
+*********************************************************************************************************
+*/
+
+static  void  FTPc_HostCachePut (const  CPU_CHAR   *p_host,
+                                        FTPc_CONN  *p_conn)
+{
+#ifdef  NET_IPv4_MODULE_EN
+    NET_SOCK_ADDR_IPv4  *p_sock_addr_ipv4;
+    NET_IPv4_ADDR        addr_ipv4;
+#endif
+#ifdef  NET_IPv6_MODULE_EN
+    NET_SOCK_ADDR_IPv6  *p_sock_addr_ipv6;
+#endif
+    FTPc_HOST_ENTRY      entry;
+    FTPc_HOST_ENTRY     *p_entry;
+    FTPc_HOST_ENTRY     *p_entry_put;
+    CPU_SIZE_T           name_len;
+    CPU_INT16U           ix;
+    CPU_SR_ALLOC();
+
+
+    name_len = Str_Len_N(p_host, FTPc_CFG_HOST_CACHE_NAME_LEN_MAX);
+    if (name_len >= FTPc_CFG_HOST_CACHE_NAME_LEN_MAX) {         /* See Note #1.                                         */
+        return;
+    }
+
+    Mem_Clr(&entry, sizeof(entry));
+    switch (p_conn->SockAddrFamily) {                           /* Store addr in the format of FTPc_Conn().             */
+#ifdef  NET_IPv4_MODULE_EN
+        case NET_IP_ADDR_FAMILY_IPv4:
+             p_sock_addr_ipv4 = (NET_SOCK_ADDR_IPv4 *)&p_conn->SockAddr;
+             addr_ipv4        =  NET_UTIL_NET_TO_HOST_32(p_sock_addr_ipv4->Addr);
+             Mem_Copy(entry.Addr, &addr_ipv4, sizeof(addr_ipv4));
+             break;
+#endif
+
+#ifdef  NET_IPv6_MODULE_EN
+        case NET_IP_ADDR_FAMILY_IPv6:
+             p_sock_addr_ipv6 = (NET_SOCK_ADDR_IPv6 *)&p_conn->SockAddr;
+             Mem_Copy(entry.Addr, &p_sock_addr_ipv6->Addr, sizeof(p_sock_addr_ipv6->Addr));
+             break;
+#endif
+
+        default:
+             return;
+    }
+
+   (void)Str_Copy_N(entry.Name, p_host, FTPc_CFG_HOST_CACHE_NAME_LEN_MAX);
+    entry.Family = p_conn->SockAddrFamily;
+    entry.TS_ms  = (CPU_INT32U)NetUtil_TS_Get_ms();
+
+    CPU_CRITICAL_ENTER();
+    p_entry_put = &FTPc_HostCache[0];
+    for (ix = 0u; ix < FTPc_CFG_HOST_CACHE_NBR_ENTRY; ix++) {   /* See Note #2.                                         */
+        p_entry = &FTPc_HostCache[ix];
+        if (p_entry->Name[0] == (CPU_CHAR)'\0') {
+            p_entry_put = p_entry;
+            continue;
+        }
+        if (Str_Cmp_N(p_entry->Name, p_host, FTPc_CFG_HOST_CACHE_NAME_LEN_MAX) == 0) {
+            p_entry_put = p_entry;
+            break;
+        }
+        if ((p_entry_put->Name[0] != (CPU_CHAR)'\0') &&
+            ((entry.TS_ms - p_entry->TS_ms) > (entry.TS_ms - p_entry_put->TS_ms))) {
+            p_entry_put = p_entry;
+        }
+    }
+   *p_entry_put = entry;
+    CPU_CRITICAL_EXIT();
+}
+#endif
+
+
+#ifdef  NET_SECURE_MODULE_EN
+/*
+*********************************************************************************************************
+*                                       FTPc_ConnSecureResume()
+*
+* Description : Open a secure data connection resuming the TLS session of the control connection.
+*
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
+*
+*               p_addr      Pointer to passive address of the data connection, in the format of
+*                           NetApp_ClientStreamOpen().
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               NET_APP_ERR_NONE                Data connection opened.
+*                               NET_APP_ERR_CONN_FAIL           Data connection failed.
+*
+*                                                               --- RETURNED BY NetSock_Open() : ---
+*                               See NetSock_Open() for additional return error codes.
+*
+* Return(s)   : Socket ID of the data connection, if no error;
+*               NET_SOCK_ID_NONE,                 otherwise.
+*
+* Caller(s)   : FTPc_Conn().
+*
+* Note(s)     : (1) The socket is opened & configured like NetApp_ClientStreamOpen() does, except that the
+*                   session is offered to the server before the TLS handshake. If the session cannot be
+*                   set on the socket, or the server refuses it, a full handshake is performed.
+*
+*               (2) Servers MAY issue a new session ticket on each handshake; the most recent session is
+*                   kept for the following data connections.
+*********************************************************************************************************
+*/
+
+static  NET_SOCK_ID  FTPc_ConnSecureResume (FTPc_CONN   *p_conn,
+                                            CPU_INT08U  *p_addr,
+                                            NET_ERR     *p_err)
+{
+    const  FTPc_CFG                  *p_cfg;
+    const  FTPc_SECURE_CFG           *p_secure_cfg;
+    const  FTPc_SECURE_SESSION_API   *p_api;
+           NET_SOCK_ADDR              sock_addr;
+           NET_SOCK_PROTOCOL_FAMILY   protocol_family;
+           NET_SOCK_ADDR_FAMILY       addr_family;
+           NET_IP_ADDR_LEN            addr_len;
+           NET_SOCK_ID                sock_id;
+           void                      *p_session;
+           NET_ERR                    err;
+
+
+    p_cfg        = p_conn->CfgPtr;
+    p_secure_cfg = p_conn->SecureCfgPtr;
+    p_api        = p_secure_cfg->SessionApiPtr;
+
+    switch (p_conn->SockAddrFamily) {
+#ifdef  NET_IPv4_MODULE_EN
+        case NET_IP_ADDR_FAMILY_IPv4:
+             protocol_family = NET_SOCK_PROTOCOL_FAMILY_IP_V4;
+             addr_family     = NET_SOCK_ADDR_FAMILY_IP_V4;
+             addr_len        = NET_IPv4_ADDR_SIZE;
+             break;
+#endif
+
+#ifdef  NET_IPv6_MODULE_EN
+        case NET_IP_ADDR_FAMILY_IPv6:
+             protocol_family = NET_SOCK_PROTOCOL_FAMILY_IP_V6;
+             addr_family     = NET_SOCK_ADDR_FAMILY_IP_V6;
+             addr_len        = NET_IPv6_ADDR_SIZE;
+             break;
+#endif
+
+        default:
+            *p_err = NET_APP_ERR_CONN_FAIL;
+             return (NET_SOCK_ID_NONE);
+    }
+
+    NetApp_SetSockAddr(&sock_addr, addr_family, p_conn->PasvPort, p_addr, addr_len, p_err);
+    if (*p_err != NET_APP_ERR_NONE) {
+        return (NET_SOCK_ID_NONE);
+    }
+                                                                /* ------------- OPEN & CFG SECURE SOCKET ------------- */
+    sock_id = NetSock_Open(protocol_family, NET_SOCK_TYPE_STREAM, NET_SOCK_PROTOCOL_TCP, p_err);
+    if (*p_err != NET_SOCK_ERR_NONE) {
+        return (NET_SOCK_ID_NONE);
+    }
+
+   (void)NetSock_CfgBlock(sock_id, NET_SOCK_BLOCK_SEL_BLOCK, p_err);
+    if (*p_err == NET_SOCK_ERR_NONE) {
+       (void)NetSock_CfgTimeoutConnReqSet(sock_id, p_cfg->DTP_ConnMaxTimout_ms, p_err);
+    }
+    if (*p_err == NET_SOCK_ERR_NONE) {
+       (void)NetSock_CfgSecure(sock_id, DEF_YES, p_err);
+    }
+    if ((*p_err                    == NET_SOCK_ERR_NONE) &&
+        ( p_secure_cfg->CommonName != DEF_NULL         )) {
+       (void)NetSock_CfgSecureClientCommonName(sock_id, p_secure_cfg->CommonName, p_err);
+    }
+    if ((*p_err                       == NET_SOCK_ERR_NONE) &&
+        ( p_secure_cfg->TrustCallback != DEF_NULL         )) {
+       (void)NetSock_CfgSecureClientTrustCallBack(sock_id, p_secure_cfg->TrustCallback, p_err);
+    }
+    if (*p_err != NET_SOCK_ERR_NONE) {
+        NetSock_Close(sock_id, &err);
+       *p_err = NET_APP_ERR_CONN_FAIL;
+        return (NET_SOCK_ID_NONE);
+    }
+
+   (void)p_api->Set(sock_id, p_conn->SecureSessionPtr);         /* See Note #1.                                         */
+
+                                                                /* ---------------- CONN & HANDSHAKE ------------------ */
+   (void)NetSock_Conn(sock_id, &sock_addr, sizeof(sock_addr), p_err);
+    if (*p_err != NET_SOCK_ERR_NONE) {
+        NetSock_Close(sock_id, &err);
+       *p_err = NET_APP_ERR_CONN_FAIL;
+        return (NET_SOCK_ID_NONE);
+    }
+
+    p_session = p_api->Get(sock_id);                            /* See Note #2.                                         */
+    if ((p_session != DEF_NULL                ) &&
+        (p_session != p_conn->SecureSessionPtr)) {
+        FTPc_SecureSessionFree(p_conn);
+        p_conn->SecureSessionPtr = p_session;
+    }
+
+   *p_err = NET_APP_ERR_NONE;
+
+    return (sock_id);
+}
+
+
+/*
+*********************************************************************************************************
+*                                      FTPc_SecureSessionFree()
+*
+* Description : Release the TLS session kept by a connection.
+*
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : FTPc_Open(),
+*               FTPc_Close(),
+*               FTPc_ConnSecureResume().
+*
+* Note(s)     : None.
+*********************************************************************************************************
+*/
+
+static  void  FTPc_SecureSessionFree (FTPc_CONN  *p_conn)
+{
+    const  FTPc_SECURE_SESSION_API  *p_api;
+
+
+    if (p_conn->SecureSessionPtr == DEF_NULL) {
+        return;
+    }
+
+    p_api = p_conn->SecureCfgPtr->SessionApiPtr;
+    if (p_api->Free != DEF_NULL) {
+        p_api->Free(p_conn->SecureSessionPtr);
+    }
+    p_conn->SecureSessionPtr = DEF_NULL;
+}
+#endif
+
+
+#if (FTPc_CFG_RATE_LIMIT_EN == DEF_ENABLED)
+/*
+*********************************************************************************************************
+*                                         FTPc_DTP_Throttle()
+*
+* Description : Account for data transferred on a connection & wait until its rate limits allow more.
+*
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
+*
+*               len         Number of octets just transferred.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : FTPc_SendBufVect(),
+*               FTPc_SendFileSrc(),
+*               FTPc_DTP_Rx().
+*
+* Note(s)     : (1) Octets are taken from the buckets after they are transferred, which MAY leave the
+*                   buckets in debt. The caller then waits until both buckets are refilled, so that the
+*                   average rate never exceeds the lowest limit.
+*********************************************************************************************************
+*/
+
+static  void  FTPc_DTP_Throttle (FTPc_CONN   *p_conn,
+                                 CPU_INT32U   len)
+{
+    CPU_INT32U  ts_ms;
+    CPU_INT32U  dly_ms;
+    CPU_INT32U  dly_global_ms;
+    CPU_SR_ALLOC();
+
+
+    ts_ms = (CPU_INT32U)NetUtil_TS_Get_ms();
+    while (DEF_TRUE) {                                          /* See Note #1.                                         */
+        CPU_CRITICAL_ENTER();
+        dly_ms        = FTPc_RateLimitTake(&p_conn->RateLimit,   len, ts_ms);
+        dly_global_ms = FTPc_RateLimitTake(&FTPc_RateLimitGlobal, len, ts_ms);
+        CPU_CRITICAL_EXIT();
+
+        dly_ms = DEF_MAX(dly_ms, dly_global_ms);
+        if (dly_ms == 0u) {
+            break;
+        }
+
+        KAL_Dly(dly_ms);
+        len   = 0u;                                             /* Octets already taken; only refill the buckets.       */
+        ts_ms = (CPU_INT32U)NetUtil_TS_Get_ms();
+    }
+}
+
 
+/*
+*********************************************************************************************************
+*                                        FTPc_RateLimitTake()
+*
+* Description : Refill a token bucket & take octets from it.
+*
+* Argument(s) : p_bucket    Pointer to token bucket.
+*
+*               len         Number of octets to take.
+*
+*               ts_ms       Current time, in milliseconds.
+*
+* Return(s)   : Delay until the bucket is no longer in debt, in milliseconds;
+*               0, if the bucket is not in debt or the limit is disabled.
+*
+* Caller(s)   : FTPc_DTP_Throttle().
+*
+* Note(s)     : (1) MUST be called in a critical section since the global bucket is shared by all
+*                   connections.
+*
+*               (2) The bucket timestamp is only advanced by the time of the whole tokens added, so that
+*                   partial tokens are not lost between frequent calls.
+*********************************************************************************************************
+*/
 
-            default:
-                 return (DEF_FAIL);
+static  CPU_INT32U  FTPc_RateLimitTake (FTPc_RATE_LIMIT  *p_bucket,
+                                        CPU_INT32U        len,
+                                        CPU_INT32U        ts_ms)
+{
+    CPU_INT64U  refill;
+    CPU_INT64S  tokens;
+    CPU_INT32U  burst;
+    CPU_INT32U  elapsed_ms;
+    CPU_INT32U  dly_ms;
+
+
+    if (p_bucket->Rate == 0u) {
+        return (0u);
+    }
+                                                                /* Refill bucket (see Note #2).                         */
+    burst      = DEF_MIN(p_bucket->Burst, DEF_INT_32S_MAX_VAL);
+    elapsed_ms = ts_ms - p_bucket->TS_ms;
+    refill     = ((CPU_INT64U)elapsed_ms * p_bucket->Rate) / 1000u;
+    if (refill > 0u) {
+        tokens = (CPU_INT64S)p_bucket->Tokens + (CPU_INT64S)refill;
+        if (tokens >= (CPU_INT64S)burst) {
+            tokens           = (CPU_INT64S)burst;
+            p_bucket->TS_ms  = ts_ms;
+        } else {
+            p_bucket->TS_ms += (CPU_INT32U)((refill * 1000u) / p_bucket->Rate);
         }
+        p_bucket->Tokens = (CPU_INT32S)tokens;
     }
 
-    if (*p_err != NET_SOCK_ERR_NONE) {
-        return (DEF_FAIL);
+    p_bucket->Tokens -= (CPU_INT32S)DEF_MIN(len, DEF_INT_32S_MAX_VAL);
+    if (p_bucket->Tokens >= 0) {
+        return (0u);
     }
 
-    if (timeout_ms != 0) {
-        NetSock_CfgTimeoutRxQ_Set(sock_id, timeout_ms_cfgd, p_err);
-    }
+    dly_ms = (CPU_INT32U)((((CPU_INT64U)(-(CPU_INT64S)p_bucket->Tokens) * 1000u) + p_bucket->Rate - 1u) / p_bucket->Rate);
 
-    return (DEF_OK);
+    return (dly_ms);
 }
+#endif
 
 
+#if (FTPc_CFG_SCHED_EN == DEF_ENABLED)
 /*
 *********************************************************************************************************
-*                                             FTPc_Conn()
+*                                         FTPc_SchedXferSet()
 *
-* Description : Connect a data socket in PASV or EPSV mode.
+* Description : Register the start or the end of a data transfer of a connection.
 *
-* Argument(s) : p_conn          Pointer to FTPc Connection object.
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
 *
-*               p_ctrl_buf      Pointer to buffer that contain the result of status message.
+*               en          DEF_YES, if a data transfer starts;
+*                           DEF_NO,  if the data transfer ended.
 *
-*               ctrl_buf_size   Size of control buffer.
+* Return(s)   : none.
 *
-*               p_err       Pointer to variable that will receive the return error code from this function :
+* Caller(s)   : FTPc_Conn(),
+*               FTPc_XferEnd().
 *
-*                               FTPc_ERR_NONE                   Data Connection was successful.
-*                               FTPc_ERR_FAULT                  Faulted because of invalid IP address family.
-*                               FTPc_ERR_TX_CMD                 Sending Command failed.
-*                               FTPc_ERR_RX_CMD_RESP_INVALID    Receiving Command response failed.
-*                               FTPc_ERR_CONN_FAIL              Connection failed.
+* Note(s)     : (1) Each connection is counted at most once, so that an extra end has no effect.
+*********************************************************************************************************
+*/
+
+static  void  FTPc_SchedXferSet (FTPc_CONN    *p_conn,
+                                 CPU_BOOLEAN   en)
+{
+    CPU_SR_ALLOC();
+
+
+    CPU_CRITICAL_ENTER();
+    if (p_conn->SchedXferEn != en) {                            /* See Note #1.                                         */
+        if (en == DEF_YES) {
+            FTPc_SchedXferCtr[p_conn->Prio]++;
+        } else {
+            FTPc_SchedXferCtr[p_conn->Prio]--;
+        }
+        p_conn->SchedXferEn = en;
+    }
+    CPU_CRITICAL_EXIT();
+}
+
+
+/*
+*********************************************************************************************************
+*                                          FTPc_SchedYield()
 *
-* Return(s)   : Data socket ID,   if no error.
-*               NET_SOCK_ID_NONE, otherwise.
+* Description : Pause the data transfer of a connection while transfers of a higher priority class are
+*               active.
 *
-* Caller(s)   : FTPc_RecvBuf(),
-*               FTPc_SendBuf(),
-*               FTPc_RecvFile(),
-*               FTPc_SendFile().
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
 *
-* Note(s)     : none.
+* Return(s)   : none.
+*
+* Caller(s)   : FTPc_SendBufVect(),
+*               FTPc_SendFileSrc(),
+*               FTPc_DTP_Rx().
+*
+* Note(s)     : (1) Called between chunks of data, so that a higher priority transfer waits for at most
+*                   one chunk of each lower priority transfer before getting the network, the file system
+*                   & the CPU. Paused transfers are checked every FTPc_SCHED_PAUSE_POLL_MS milliseconds.
+*
+*               (2) The data connection of a paused transfer remains open. The data connection idle
+*                   timeout of the server MUST be longer than the pause of the transfer (see Note #3).
+*
+*               (3) A pause ends after FTPc_CFG_SCHED_PAUSE_MAX_MS milliseconds per priority class between
+*                   the class of the transfer & the highest active class, even if higher priority
+*                   transfers are still active. Each transfer is thus guaranteed a minimum share of the
+*                   bandwidth, weighted by its priority class, & a steady stream of higher priority
+*                   transfers cannot starve it.
 *********************************************************************************************************
 */
-static  NET_SOCK_ID  FTPc_Conn (FTPc_CONN   *p_conn,
-                                CPU_CHAR    *p_ctrl_buf,
-                                CPU_INT16U   ctrl_buf_size,
-                                FTPc_ERR    *p_err)
+
+static  void  FTPc_SchedYield (FTPc_CONN  *p_conn)
 {
-#ifdef  NET_IPv4_MODULE_EN
-           NET_IPv4_ADDR             server_ipv4;
-           CPU_INT32S                tmp_val;
-#endif
-#ifdef  NET_IPv6_MODULE_EN
-           NET_SOCK_ADDR_IPv6       *p_sock_addr_ipv6;
+    CPU_INT32U  pause_ms;
+    CPU_INT32U  pause_max_ms;
+    CPU_INT08U  prio;
+    CPU_SR_ALLOC();
+
+
+    pause_ms = 0u;
+    while (DEF_TRUE) {
+        CPU_CRITICAL_ENTER();                                   /* Find highest active class.                           */
+        for (prio = 0u; prio < p_conn->Prio; prio++) {
+            if (FTPc_SchedXferCtr[prio] > 0u) {
+                break;
+            }
+        }
+        CPU_CRITICAL_EXIT();
+
+        if (prio >= p_conn->Prio) {
+            break;
+        }
+                                                                /* See Note #3.                                         */
+        pause_max_ms = (CPU_INT32U)(p_conn->Prio - prio) * FTPc_CFG_SCHED_PAUSE_MAX_MS;
+        if (pause_ms >= pause_max_ms) {
+            FTPc_TRACE_DBG(("FTPc paused transfer resumed for one chunk, line #%u.\n", (unsigned int)__LINE__));
+            break;
+        }
+
+        KAL_Dly(FTPc_SCHED_PAUSE_POLL_MS);                      /* See Note #1.                                         */
+        pause_ms += FTPc_SCHED_PAUSE_POLL_MS;
+    }
+}
 #endif
-    const  FTPc_CFG                 *p_cfg;
-           NET_APP_SOCK_SECURE_CFG  *p_secure = DEF_NULL;
-           CPU_INT08U               *p_addr;
-           NET_IP_ADDR_FAMILY        ip_addr_family;
-           NET_SOCK_ID               sock_dtp_id;
-           CPU_INT32U                buf_size;
-           CPU_INT16U                server_port;
-           CPU_CHAR                 *tmp_buf;
-           CPU_INT32U                reply_code;
-           CPU_BOOLEAN               rtn_code;
-           NET_ERR                   err;
 
 
-    p_cfg = FTPc_CfgPtr;
+#if (FTPc_CFG_TRACE_BUF_EN == DEF_ENABLED)
+/*
+*********************************************************************************************************
+*                                            FTPc_TraceWr()
+*
+* Description : Write an event record to the trace buffer.
+*
+* Argument(s) : evt_id      Trace event ID (see 'ftp-c.h  FTPc TRACE BUFFER').
+*
+*               arg0        First  event argument.
+*
+*               arg1        Second event argument.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : FTPc_TRACE_EVT().
+*
+* Note(s)     : (1) Only the reservation of the record slot is performed in a critical section. The
+*                   sequence number of the slot is first set to a value that is never valid for the slot,
+*                   so that readers detect the overwrite of the previous record. The record is then
+*                   filled outside of the critical section & its sequence number is written last to
+*                   mark the record as complete. Memory barriers order the invalidation before the
+*                   record fields & the record fields before the final sequence number (see 'ftp-c.h
+*                   FTPc TRACE BUFFER  Note #4').
+*
+*               (2) The oldest records are overwritten once the trace buffer is full.
+*********************************************************************************************************
+*/
 
-    switch (p_conn->SockAddrFamily) {
-#ifdef  NET_IPv4_MODULE_EN
-        case NET_IP_ADDR_FAMILY_IPv4:
-             buf_size = Str_FmtPrint((char *)p_ctrl_buf, ctrl_buf_size, "%s\r\n", FTPc_Cmd[FTP_CMD_PASV].CmdStr);
-             break;
+static  void  FTPc_TraceWr (CPU_INT16U  evt_id,
+                            CPU_INT32U  arg0,
+                            CPU_INT32U  arg1)
+{
+    FTPc_TRACE_REC  *p_rec;
+    CPU_INT32U       ix;
+    CPU_SR_ALLOC();
+
+
+    CPU_CRITICAL_ENTER();                                       /* See Note #1.                                         */
+    ix           =  FTPc_TraceBuf.Ix;
+    FTPc_TraceBuf.Ix++;
+    p_rec        = &FTPc_TraceBuf.Tbl[ix & (FTPc_CFG_TRACE_BUF_NBR_EVT - 1u)];
+    p_rec->Seq   = (CPU_INT16U)(ix - 1u);                       /* Invalidate slot.                                     */
+    FTPc_TRACE_MB();
+    CPU_CRITICAL_EXIT();
+                                                                /* See Note #2.                                         */
+    p_rec->TS    =  FTPc_TS_GET();
+    p_rec->EvtID =  evt_id;
+    p_rec->Arg0  =  arg0;
+    p_rec->Arg1  =  arg1;
+    FTPc_TRACE_MB();                                            /* Complete record before validating it.                */
+    p_rec->Seq   = (CPU_INT16U)ix;
+}
 #endif
 
-        case NET_IP_ADDR_FAMILY_IPv6:
-             buf_size = Str_FmtPrint((char *)p_ctrl_buf, ctrl_buf_size, "%s\r\n", FTPc_Cmd[FTP_CMD_EPSV].CmdStr);
-             break;
 
-        default:
-            *p_err = FTPc_ERR_FAULT;
-             return (NET_SOCK_ID_NONE);
-    }
+#if (FTPc_CFG_HIST_EN == DEF_ENABLED)
+/*
+*********************************************************************************************************
+*                                          FTPc_HistCmdStart()
+*
+* Description : Start timing a command transmitted on the control socket.
+*
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
+*
+*               p_cmd       Pointer to command line.
+*
+*               cmd_len     Length of command line.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : FTPc_Tx().
+*
+* Note(s)     : (1) The command code is found from the command line so that every command sent through
+*                   FTPc_Tx() is timed. Unknown commands are not timed.
+*********************************************************************************************************
+*/
 
-    rtn_code = FTPc_Tx(p_conn->SockID,
-                       p_ctrl_buf,
-                       buf_size,
-                       p_cfg->CtrlTxMaxTimout_ms,
-                       p_cfg->CtrlTxMaxRetry,
-                       p_cfg->CtrlTxMaxDly_ms,
-                      &err);
-    FTPc_TRACE_INFO(("FTPc TX: %s", p_ctrl_buf));
-    if (rtn_code == DEF_FAIL) {
-       *p_err = FTPc_ERR_TX_CMD;
-        return (NET_SOCK_ID_NONE);
+static  void  FTPc_HistCmdStart (FTPc_CONN   *p_conn,
+                                 CPU_CHAR    *p_cmd,
+                                 CPU_INT16U   cmd_len)
+{
+    CPU_INT08U  cmd_code;
+    CPU_SIZE_T  str_len;
+
+
+    p_conn->HistCmdCode = FTP_CMD_MAX;                          /* See Note #1.                                         */
+    for (cmd_code = 0u; cmd_code < FTP_CMD_MAX; cmd_code++) {
+        str_len = Str_Len(FTPc_Cmd[cmd_code].CmdStr);
+        if ((str_len < cmd_len) &&
+            (Str_Cmp_N(p_cmd, FTPc_Cmd[cmd_code].CmdStr, str_len) == 0) &&
+           ((p_cmd[str_len] == ' ') || (p_cmd[str_len] == '\r'))) {
+            p_conn->HistCmdCode = cmd_code;
+            p_conn->HistTS      = FTPc_TS_GET();
+            break;
+        }
     }
-
-                                                                /* Receive status line.                                 */
-    reply_code = FTPc_WaitForStatus(p_conn, p_ctrl_buf, ctrl_buf_size, &err);
+}
 
 
-    switch (p_conn->SockAddrFamily) {
-#ifdef  NET_IPv4_MODULE_EN
-        case NET_IP_ADDR_FAMILY_IPv4:
-             if (reply_code != FTP_REPLY_CODE_ENTERPASVMODE) {
-                *p_err = FTPc_ERR_RX_CMD_RESP_INVALID;
-                 return (NET_SOCK_ID_NONE);
-             }
+/*
+*********************************************************************************************************
+*                                           FTPc_HistCmdEnd()
+*
+* Description : Record the round-trip latency of the command waiting for its reply, if any.
+*
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : FTPc_WaitForStatus().
+*
+* Note(s)     : (1) Only the first reply of a command is timed; secondary replies, e.g. the completion
+*                   reply of a transfer command, include the duration of the transfer.
+*********************************************************************************************************
+*/
 
-             server_ipv4  = 0;
-             server_port  = 0;
-             tmp_buf      = Str_Char(p_ctrl_buf, '(');
-             tmp_buf++;
+static  void  FTPc_HistCmdEnd (FTPc_CONN  *p_conn)
+{
+    CPU_TS32  ts_delta;
 
-             tmp_val      = Str_ParseNbr_Int32U(tmp_buf, &tmp_buf, 10);  /* Get IP Address MSB.                                  */
-             tmp_buf++;
-             server_ipv4 += tmp_val << 24;
 
-             tmp_val      = Str_ParseNbr_Int32U(tmp_buf, &tmp_buf, 10);
-             tmp_buf++;
-             server_ipv4 += tmp_val << 16;
+    if (p_conn->HistCmdCode >= FTP_CMD_MAX) {
+        return;
+    }
 
-             tmp_val      = Str_ParseNbr_Int32U(tmp_buf, &tmp_buf, 10);
-             tmp_buf++;
-             server_ipv4 += tmp_val << 8;
+    ts_delta = FTPc_TS_GET() - p_conn->HistTS;
+    FTPc_HistUpdate(FTPc_Hist.CmdLat[p_conn->HistCmdCode], FTPc_TS_TO_uS(ts_delta));
 
-             tmp_val      = Str_ParseNbr_Int32U(tmp_buf, &tmp_buf, 10);  /* Get IP Address LSB.                                  */
-             tmp_buf++;
-             server_ipv4 += tmp_val << 0;
+    p_conn->HistCmdCode = FTP_CMD_MAX;                          /* See Note #1.                                         */
+}
 
-             tmp_val      = Str_ParseNbr_Int32U(tmp_buf, &tmp_buf, 10);  /* Get IP Port MSB.                                     */
-             tmp_buf++;
-             server_port += tmp_val << 8;
 
-             tmp_val      = Str_ParseNbr_Int32U(tmp_buf, &tmp_buf, 10);  /* Get IP Port LSB.                                     */
-             tmp_buf++;
-             server_port += tmp_val << 0;
+/*
+*********************************************************************************************************
+*                                          FTPc_HistXferEnd()
+*
+* Description : Record the throughput of a completed data transfer.
+*
+* Argument(s) : p_conn      Pointer to FTPc Connection object.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : FTPc_XferEnd().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
 
-             ip_addr_family =  NET_IP_ADDR_FAMILY_IPv4;
-             p_addr         = (CPU_INT08U *)&server_ipv4;
-             break;
-#endif
+static  void  FTPc_HistXferEnd (FTPc_CONN  *p_conn)
+{
+    CPU_INT64U  time_us;
+    CPU_INT64U  rate;
 
-#ifdef  NET_IPv6_MODULE_EN
-        case NET_IP_ADDR_FAMILY_IPv6:
-             if (reply_code != FTP_REPLY_CODE_ENTEREXTPASVMODE) {
-                *p_err = FTPc_ERR_RX_CMD_RESP_INVALID;
-                 return (NET_SOCK_ID_NONE);
-             }
 
-             tmp_buf          =  Str_Str(p_ctrl_buf, FTP_ASCII_EPSV_PREFIX);
-             tmp_buf          =  tmp_buf + Str_Len(FTP_ASCII_EPSV_PREFIX);
-             server_port      =  Str_ParseNbr_Int32U(tmp_buf, &tmp_buf, 10);
-             ip_addr_family   =  NET_IP_ADDR_FAMILY_IPv6;
-             p_sock_addr_ipv6 = (NET_SOCK_ADDR_IPv6 *)&p_conn->SockAddr;
-             p_addr           = (CPU_INT08U         *)&p_sock_addr_ipv6->Addr;
-             break;
-#endif
+    time_us = FTPc_TS_TO_uS(FTPc_TS_GET() - p_conn->HistXferTS);
+    if (time_us == 0u) {
+        time_us = 1u;
+    }
 
-        default:
-            *p_err = FTPc_ERR_FAULT;
-             return (NET_SOCK_ID_NONE);
+    rate = ((CPU_INT64U)p_conn->HistXferLen * 1000000u) / time_us;
+    if (rate > DEF_INT_32U_MAX_VAL) {
+        rate = DEF_INT_32U_MAX_VAL;
     }
 
-#ifdef  NET_SECURE_MODULE_EN
-    p_secure    = (NET_APP_SOCK_SECURE_CFG *)p_conn->SecureCfgPtr;
-#endif
-    sock_dtp_id = NetApp_ClientStreamOpen( p_addr,
-                                           ip_addr_family,
-                                           server_port,
-                                           DEF_NULL,
-                                           p_secure,
-                                           p_cfg->DTP_ConnMaxTimout_ms,
-                                          &err);
-    switch (err) {
-        case NET_APP_ERR_NONE:
-             break;
+    FTPc_HistUpdate(FTPc_Hist.XferRate, (CPU_INT32U)rate);
+}
 
-        case NET_APP_ERR_CONN_FAIL:
-        case NET_ERR_IF_LINK_DOWN:
-            *p_err = FTPc_ERR_CONN_FAIL;
-             return (NET_SOCK_ID_NONE);
 
-        default:
-           *p_err = FTPc_ERR_FAULT;
-            return (NET_SOCK_ID_NONE);
-    }
+/*
+*********************************************************************************************************
+*                                           FTPc_HistUpdate()
+*
+* Description : Count a sample in a histogram.
+*
+* Argument(s) : p_bkt_tbl   Pointer to histogram buckets.
+*
+*               val         Sample value.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : FTPc_HistCmdEnd(),
+*               FTPc_HistXferEnd(),
+*               FTPc_HIST_CONN_END().
+*
+* Note(s)     : (1) See 'ftp-c.h  FTPc HISTOGRAMS DATA TYPE  Note #2'.
+*
+*               (2) Histograms are shared by all connections & MAY be updated from several tasks.
+*********************************************************************************************************
+*/
 
-   *p_err = FTPc_ERR_NONE;
+static  void  FTPc_HistUpdate (CPU_INT32U  *p_bkt_tbl,
+                               CPU_INT32U   val)
+{
+    CPU_INT08U  msb;
+    CPU_INT08U  bkt_ix;
+    CPU_SR_ALLOC();
 
-    return (sock_dtp_id);
+
+    if (val < 2u) {                                             /* See Note #1.                                         */
+        bkt_ix = (CPU_INT08U)val;
+    } else {
+        msb    = (CPU_INT08U)(31u - CPU_CntLeadZeros32(val));
+        bkt_ix = (CPU_INT08U)((msb * 2u) + ((val >> (msb - 1u)) & 1u));
+    }
+
+    CPU_CRITICAL_ENTER();                                       /* See Note #2.                                         */
+    p_bkt_tbl[bkt_ix]++;
+    CPU_CRITICAL_EXIT();
 }
+#endif
@@ -163,16 +163,146 @@
 *********************************************************************************************************
 *                                        FTPc SPECIFIC DEFINES
 *
-* Note(s) : (1) The size of FTPc_CTRL_NET_BUF_SIZE must be large enough to accommodate a complete
-*               reply line. However, it is possible for the length of a server's welcome message to
-*               span multiple buffer sizes.
+* Note(s) : (1) The size of FTPc_CTRL_NET_BUF_SIZE is configured by FTPc_CFG_CTRL_BUF_SIZE & must be
+*               large enough to accommodate a complete command line as well as the reply lines that
+*               are parsed by the client (i.e. SIZE, PASV & EPSV replies).
+*
+*               (a) Server replies are processed one line at a time. Lines that do not fit in the
+*                   buffer (e.g. lengthy welcome banners or FEAT replies) are streamed & discarded
+*                   once their reply code has been decoded.
 *********************************************************************************************************
 */
 
-#define  FTPc_CTRL_NET_BUF_SIZE                         1460    /* Ctrl buffer size.                                    */
+#define  FTPc_CTRL_NET_BUF_SIZE         FTPc_CFG_CTRL_BUF_SIZE  /* Ctrl buffer size.                                    */
 #define  FTPc_DTP_NET_BUF_SIZE                          1460    /* Dtp buffer size.                                     */
 
 
+/*
+*********************************************************************************************************
+*                                           FTPc TIMESTAMP
+*
+* Note(s) : (1) FTPc_TS_GET() returns the timestamps recorded in FTPc statistics. It defaults to the
+*               CPU timestamp & MAY be #define'd in 'ftp-c_cfg.h' to use another clock source.
+*
+*           (2) FTPc_TS_TO_uS() converts a difference of FTPc_TS_GET() timestamps to microseconds. It
+*               MUST be #define'd along with FTPc_TS_GET() when another clock source is used.
+*
+*           (3) The default CPU timestamp requires CPU_CFG_TS_32_EN to be DEF_ENABLED in 'cpu_cfg.h'
+*               when statistics, histograms or the trace buffer are enabled, since CPU_TS_Get32() &
+*               CPU_TS32_to_uSec() are otherwise not available (see 'CONFIGURATION ERRORS').
+*********************************************************************************************************
+*/
+
+#ifndef  FTPc_TS_GET                                            /* See Note #1.                                         */
+#define  FTPc_TS_GET()                          CPU_TS_Get32()
+#define  FTPc_TS_DFLT_EN                                   1u   /* CPU timestamp used (see Note #3).                    */
+#endif
+
+#ifndef  FTPc_TS_TO_uS                                          /* See Note #2.                                         */
+#define  FTPc_TS_TO_uS(ts)                      CPU_TS32_to_uSec(ts)
+#ifndef  FTPc_TS_DFLT_EN
+#define  FTPc_TS_DFLT_EN                                   1u   /* CPU timestamp used (see Note #3).                    */
+#endif
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      FTPc SOCKET DATA INTERFACE
+*
+* Note(s) : (1) FTPc_SOCK_RX_DATA() & FTPc_SOCK_TX_DATA() are used for every data octet received or
+*               transmitted on the control & data sockets. They default to the network socket API & MAY
+*               be #define'd in 'ftp-c_cfg.h' to interpose another layer, e.g. a test harness that
+*               injects delays, bandwidth limits, fragmentation or transient errors between FTPc & the
+*               network stack.
+*
+*           (2) Replacement functions MUST have the same arguments & return the same values & error
+*               codes as NetSock_RxData() & NetSock_TxData().
+*********************************************************************************************************
+*/
+
+#ifndef  FTPc_SOCK_RX_DATA                                      /* See Note #1.                                         */
+#define  FTPc_SOCK_RX_DATA(sock_id, p_data, data_len, flags, p_err)     NetSock_RxData((sock_id), (p_data), (data_len), (flags), (p_err))
+#endif
+
+#ifndef  FTPc_SOCK_TX_DATA
+#define  FTPc_SOCK_TX_DATA(sock_id, p_data, data_len, flags, p_err)     NetSock_TxData((sock_id), (p_data), (data_len), (flags), (p_err))
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          FTP COMMAND CODES
+*
+* Note(s) : (1) Command codes index the command latency histograms (see 'FTPc HISTOGRAMS DATA TYPE').
+*********************************************************************************************************
+*/
+
+#define  FTP_CMD_NOOP                                      0
+#define  FTP_CMD_QUIT                                      1
+#define  FTP_CMD_REIN                                      2
+#define  FTP_CMD_SYST                                      3
+#define  FTP_CMD_FEAT                                      4
+#define  FTP_CMD_HELP                                      5
+#define  FTP_CMD_USER                                      6
+#define  FTP_CMD_PASS                                      7
+#define  FTP_CMD_MODE                                      8
+#define  FTP_CMD_TYPE                                      9
+#define  FTP_CMD_STRU                                     10
+#define  FTP_CMD_PASV                                     11
+#define  FTP_CMD_PORT                                     12
+#define  FTP_CMD_PWD                                      13
+#define  FTP_CMD_CWD                                      14
+#define  FTP_CMD_CDUP                                     15
+#define  FTP_CMD_MKD                                      16
+#define  FTP_CMD_RMD                                      17
+#define  FTP_CMD_NLST                                     18
+#define  FTP_CMD_LIST                                     19
+#define  FTP_CMD_RETR                                     20
+#define  FTP_CMD_STOR                                     21
+#define  FTP_CMD_APPE                                     22
+#define  FTP_CMD_REST                                     23
+#define  FTP_CMD_DELE                                     24
+#define  FTP_CMD_RNFR                                     25
+#define  FTP_CMD_RNTO                                     26
+#define  FTP_CMD_SIZE                                     27
+#define  FTP_CMD_MDTM                                     28
+#define  FTP_CMD_PBSZ                                     29
+#define  FTP_CMD_PROT                                     30
+#define  FTP_CMD_EPSV                                     31
+#define  FTP_CMD_EPRT                                     32
+#define  FTP_CMD_ABOR                                     33
+#define  FTP_CMD_MAX                                      34    /* This line MUST be the LAST!                          */
+
+
+/*
+*********************************************************************************************************
+*                                            FTP DATA TYPE
+*
+* Note(s) : (1) Data types "ASCII" & "IMAGE" supported only (see FTPc_TypeSet()).
+*********************************************************************************************************
+*/
+
+#define  FTP_TYPE_ASCII                                  'A'    /* See Note #1.                                         */
+#define  FTP_TYPE_EBCDIC                                 'E'
+#define  FTP_TYPE_IMAGE                                  'I'
+#define  FTP_TYPE_LOCAL                                  'L'
+
+
+/*
+*********************************************************************************************************
+*                                      FTP DATA PROTECTION LEVEL
+*
+* Note(s) : (1) Protection levels "Clear" & "Private" supported only (see FTPc_ProtSet()).
+*********************************************************************************************************
+*/
+
+#define  FTP_PROT_CLEAR                                  'C'    /* See Note #1.                                         */
+#define  FTP_PROT_SAFE                                   'S'
+#define  FTP_PROT_CONFIDENTIAL                           'E'
+#define  FTP_PROT_PRIVATE                                'P'
+
+
 /*
 *********************************************************************************************************
 *                                             DATA TYPES
@@ -195,6 +325,7 @@ typedef enum ftpc_err {
 
     FTPc_ERR_CONN_FAIL,
     FTPc_ERR_TX_CMD,
+    FTPc_ERR_CMD_LEN,
 
     FTPc_ERR_RX_CMD_RESP_FAIL,
     FTPc_ERR_RX_CMD_RESP_INVALID,
@@ -205,23 +336,426 @@ typedef enum ftpc_err {
 
     FTPc_ERR_FILE_NOT_FOUND,
     FTPc_ERR_FILE_OPEN_FAIL,
+    FTPc_ERR_FILE_WR_FAIL,
+
+    FTPc_ERR_FILE_BUF_LEN,
 
-    FTPc_ERR_FILE_BUF_LEN
+    FTPc_ERR_RX_TIMEOUT,
+
+    FTPc_ERR_BLK_DEV_ERASE,
+    FTPc_ERR_BLK_DEV_WR,
+    FTPc_ERR_BLK_DEV_VERIFY
 } FTPc_ERR;
 
 
 /*
 *********************************************************************************************************
 *                                      FTP SECURE CFG DATA TYPE
+*
+* Note(s) : (1) The first members of FTPc_SECURE_CFG MUST match NET_APP_SOCK_SECURE_CFG since the
+*               configuration is passed as is to the network application interface.
+*
+*           (2) SessionApiPtr is optional; MAY be a pointer to NULL. When set, the TLS session of the
+*               control connection is kept in the connection & resumed by each data connection, which
+*               avoids a full handshake per transfer. Most servers require this resumption. The
+*               functions are implemented by the application for the TLS library of the network
+*               security layer :
+*
+*               (a) Get         Return a handle to the session negotiated on the connected socket,
+*                               or a pointer to NULL if none.
+*               (b) Set         Offer the session on the next handshake of the socket, before it is
+*                               connected. Return DEF_FAIL if the session cannot be offered.
+*               (c) Free        Optional; MAY be a pointer to NULL. Release a session handle returned
+*                               by Get() that is no longer used.
 *********************************************************************************************************
 */
 
+typedef  struct  ftpc_secure_session_api {
+    void         *(*Get) (NET_SOCK_ID   sock_id);               /* See Note #2a.                                        */
+
+    CPU_BOOLEAN   (*Set) (NET_SOCK_ID   sock_id,                /* See Note #2b.                                        */
+                          void         *p_session);
+
+    void          (*Free)(void         *p_session);             /* See Note #2c.                                        */
+} FTPc_SECURE_SESSION_API;
+
 typedef  struct  ftpc_secure_cfg {
-    CPU_CHAR                    *CommonName;
-    NET_SOCK_SECURE_TRUST_FNCT   TrustCallback;
+           CPU_CHAR                    *CommonName;             /* See Note #1.                                         */
+           NET_SOCK_SECURE_TRUST_FNCT   TrustCallback;
+    const  FTPc_SECURE_SESSION_API     *SessionApiPtr;          /* See Note #2.                                         */
 } FTPc_SECURE_CFG;
 
 
+/*
+*********************************************************************************************************
+*                                    FTPc BUFFER SEGMENT DATA TYPE
+*********************************************************************************************************
+*/
+
+typedef  struct  ftpc_buf_seg {
+    void        *DataPtr;                                       /* Ptr to seg data.                                     */
+    CPU_INT32U   Len;                                           /* Len of seg data, in octets.                          */
+    CPU_INT32U   LenUsed;                                       /* Nbr of octets rx'd in seg by FTPc_RecvBufChain().    */
+} FTPc_BUF_SEG;
+
+
+/*
+*********************************************************************************************************
+*                                   FTPc FILE SOURCE API DATA TYPE
+*
+* Note(s) : (1) A file source provides the contents of the files sent by FTPc_SendFileSrc() :
+*
+*               (a) Open        Open the named file for reading. Returns a file handle, or a pointer to
+*                               NULL if the file cannot be opened.
+*               (b) Map         Optional; MAY be a pointer to NULL. Returns a pointer to the whole file
+*                               contents & sets its length, if the contents are contiguous in memory
+*                               (e.g. memory-mapped or execute-in-place flash). Returns a pointer to
+*                               NULL to have the file read with Rd().
+*               (c) Rd          Read up to 'size' octets of the file into 'p_dest' & set the number of
+*                               octets read, which is 0 at the end of the file only; fewer octets than
+*                               requested MAY be read before the end of the file. Returns DEF_OK, or
+*                               DEF_FAIL on read error. The prototype matches NetFS_FileRd().
+*               (d) Close       Close the file. The mapping returned by Map(), if any, MUST remain
+*                               valid until Close() is called. The prototype matches NetFS_FileClose().
+*
+*           (2) Mapped file contents are transmitted without being copied to an intermediate buffer.
+*********************************************************************************************************
+*/
+
+typedef  struct  ftpc_file_src_api {
+    void         *(*Open) (CPU_CHAR    *p_name);                /* See Note #1a.                                        */
+
+    const  void  *(*Map)  (void        *p_file,                 /* See Note #1b.                                        */
+                           CPU_SIZE_T  *p_len);
+
+    CPU_BOOLEAN   (*Rd)   (void        *p_file,                 /* See Note #1c.                                        */
+                           void        *p_dest,
+                           CPU_SIZE_T   size,
+                           CPU_SIZE_T  *p_size_rd);
+
+    void          (*Close)(void        *p_file);                /* See Note #1d.                                        */
+} FTPc_FILE_SRC_API;
+
+
+/*
+*********************************************************************************************************
+*                                      FTPc FILE BATCH DATA TYPES
+*
+* Note(s) : (1) See FTPc_SendFileBatch().
+*********************************************************************************************************
+*/
+
+typedef  struct  ftpc_file_pair {
+    CPU_CHAR  *LocalNamePtr;                                    /* Name of local file.                                  */
+    CPU_CHAR  *RemoteNamePtr;                                   /* Name of file in FTP server.                          */
+} FTPc_FILE_PAIR;
+
+typedef  void  (*FTPc_XFER_RESULT_FNCT)(CPU_SIZE_T   file_ix,   /* Result of a file xfer (see Note #1).                 */
+                                        FTPc_ERR     err,
+                                        void        *p_arg);
+
+
+/*
+*********************************************************************************************************
+*                                   FTPc REMOTE OPERATION DATA TYPE
+*
+* Note(s) : (1) Remote operations are identified by the code of their FTP command :
+*
+*                   FTP_CMD_DELE        Delete file PathPtr.
+*                   FTP_CMD_RNFR        Rename file or directory PathPtr to NewPathPtr.
+*                   FTP_CMD_MKD         Create directory PathPtr.
+*                   FTP_CMD_RMD         Remove directory PathPtr.
+*                   FTP_CMD_CWD         Change working directory to PathPtr.
+*
+*           (2) Err receives the result of the operation (see FTPc_RemoteOpBatch() Note #1).
+*********************************************************************************************************
+*/
+
+typedef  struct  ftpc_remote_op {
+    CPU_INT08U   Op;                                            /* Op cmd code (see Note #1).                           */
+    CPU_CHAR    *PathPtr;                                       /* Path of file or dir.                                 */
+    CPU_CHAR    *NewPathPtr;                                    /* New path of renamed file or dir.                     */
+    FTPc_ERR     Err;                                           /* Result of op (see Note #2).                          */
+} FTPc_REMOTE_OP;
+
+
+/*
+*********************************************************************************************************
+*                                     FTPc METADATA CACHE DATA TYPE
+*
+* Note(s) : (1) When FTPc_CFG_META_CACHE_EN is DEF_ENABLED, each connection caches the metadata of up to
+*               FTPc_CFG_META_CACHE_NBR_ENTRY remote paths for FTPc_CFG_META_CACHE_TTL_MS milliseconds.
+*               Entries are invalidated by the operations of the connection that modify the path :
+*
+*               (a) Uploads to the path.
+*               (b) Remote operations on the path (see FTPc_RemoteOpBatch() Note #4).
+*
+*               Changes made on the server by other clients are seen once the entry expires.
+*
+*           (2) Year, Month, Day, Hr, Min & Sec are the UTC modification time of the file, or 0 if not
+*               reported by the server.
+*********************************************************************************************************
+*/
+
+typedef  struct  ftpc_file_info {
+    CPU_BOOLEAN  Exists;                                        /* File exists on server.                               */
+    CPU_INT32U   Size;                                          /* Size of file, in octets.                             */
+    CPU_INT16U   Year;                                          /* Modification time (see Note #2).                     */
+    CPU_INT08U   Month;
+    CPU_INT08U   Day;
+    CPU_INT08U   Hr;
+    CPU_INT08U   Min;
+    CPU_INT08U   Sec;
+} FTPc_FILE_INFO;
+
+#if (FTPc_CFG_META_CACHE_EN == DEF_ENABLED)
+typedef  struct  ftpc_meta_entry {
+    CPU_CHAR        Path[FTPc_CFG_META_CACHE_PATH_LEN_MAX];     /* Remote path; empty if entry is free.                 */
+    FTPc_FILE_INFO  Info;
+    CPU_INT32U      TS_ms;                                      /* Time the metadata was rx'd.                          */
+} FTPc_META_ENTRY;
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                     FTPc BLOCK DEVICE DATA TYPE
+*
+* Note(s) : (1) A block device receives the files downloaded by FTPc_RecvBlkDev() at its start address 0 :
+*
+*               (a) Erase       Erase the sector at 'addr'. The erase MAY complete asynchronously;
+*                               Wr() & Verify() MUST then wait for its completion if required by the
+*                               device.
+*               (b) Wr          Write 'len' octets at 'addr', which are always a whole block.
+*               (c) Verify      Optional; MAY be a pointer to NULL. Compare 'len' octets at 'addr' with
+*                               'p_src'.
+*
+*               All functions return DEF_OK, or DEF_FAIL on device error.
+*
+*           (2) Size MUST be a multiple of SecSize, which MUST be a multiple of BlkSize. BlkSize is the
+*               size of the device's write unit (e.g. a flash page) & MUST be <= 65535.
+*
+*           (3) The block buffer MUST be BlkSize octets long & aligned as required by the device.
+*********************************************************************************************************
+*/
+
+typedef  struct  ftpc_blk_dev_api {
+    CPU_BOOLEAN  (*Erase) (      void        *p_dev,            /* See Note #1a.                                        */
+                                 CPU_INT32U   addr);
+
+    CPU_BOOLEAN  (*Wr)    (      void        *p_dev,            /* See Note #1b.                                        */
+                                 CPU_INT32U   addr,
+                           const void        *p_src,
+                                 CPU_SIZE_T   len);
+
+    CPU_BOOLEAN  (*Verify)(      void        *p_dev,            /* See Note #1c.                                        */
+                                 CPU_INT32U   addr,
+                           const void        *p_src,
+                                 CPU_SIZE_T   len);
+} FTPc_BLK_DEV_API;
+
+typedef  struct  ftpc_blk_dev {
+    const  FTPc_BLK_DEV_API  *ApiPtr;
+           void              *DevPtr;                           /* Dev data passed to API functions.                    */
+           CPU_INT32U         Size;                             /* Dev size, in octets (see Note #2).                   */
+           CPU_INT32U         SecSize;                          /* Erase sector size, in octets.                        */
+           CPU_INT32U         BlkSize;                          /* Wr blk size, in octets.                              */
+           CPU_INT08U        *BufPtr;                           /* Blk buf (see Note #3).                               */
+} FTPc_BLK_DEV;
+
+
+/*
+*********************************************************************************************************
+*                                       FTPc STATISTICS DATA TYPE
+*
+* Note(s) : (1) Timestamps are taken with FTPc_TS_GET() at the end of each phase of an operation :
+*
+*               (a) TS_Conn         Control connection established, including host name resolution.
+*               (b) TS_Login        Login accepted by the server.
+*               (c) TS_Pasv         Passive data port received from the server.
+*               (d) TS_DataConn     Data connection established.
+*               (e) TS_XferCmd      Transfer command accepted by the server.
+*               (f) TS_FirstByte    First data octets received or transmitted.
+*               (g) TS_LastByte     Data transfer loop completed.
+*               (h) TS_End          Operation completed successfully.
+*
+*           (2) Call & error counters include the operations on both the control & data sockets.
+*********************************************************************************************************
+*/
+
+#if (FTPc_CFG_STAT_EN == DEF_ENABLED)
+typedef  struct  ftpc_stat {
+    CPU_TS32    TS_Start;                                       /* Start of operation.                                  */
+    CPU_TS32    TS_Conn;                                        /* See Note #1.                                         */
+    CPU_TS32    TS_Login;
+    CPU_TS32    TS_Pasv;
+    CPU_TS32    TS_DataConn;
+    CPU_TS32    TS_XferCmd;
+    CPU_TS32    TS_FirstByte;
+    CPU_TS32    TS_LastByte;
+    CPU_TS32    TS_End;
+
+    CPU_INT32U  RxBytes;                                        /* Nbr of data octets rx'd.                             */
+    CPU_INT32U  TxBytes;                                        /* Nbr of data octets tx'd.                             */
+    CPU_INT32U  RxCallCtr;                                      /* Nbr of NetSock_RxData() calls (see Note #2).         */
+    CPU_INT32U  TxCallCtr;                                      /* Nbr of NetSock_TxData() calls.                       */
+    CPU_INT32U  TxRetryCtr;                                     /* Nbr of FTPc_Tx() retries.                            */
+    CPU_INT32U  ErrTransientCtr;                                /* Nbr of transient socket errors.                      */
+} FTPc_STAT;
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          FTPc TRACE BUFFER
+*
+* Note(s) : (1) When FTPc_CFG_TRACE_BUF_EN is DEF_ENABLED, FTPc records binary events in the global
+*               FTPc_TraceBuf ring buffer instead of formatting them. The buffer can be dumped by a
+*               debugger & decoded offline, or read on target with FTPc_TraceRd().
+*
+*           (2) Each record is 16 octets long, in the CPU's native byte order :
+*
+*                   Offset  Size    Field
+*                     0       4     TS      Timestamp from FTPc_TS_GET().
+*                     4       2     EvtID   Event ID (see Note #3).
+*                     6       2     Seq     16 least significant bits of the record index.
+*                     8       4     Arg0    First  event argument.
+*                    12       4     Arg1    Second event argument.
+*
+*               FTPc_TraceBuf.Ix holds the total number of records written; the record at index 'i' is
+*               located at FTPc_TraceBuf.Tbl[i % FTPc_CFG_TRACE_BUF_NBR_EVT].
+*
+*           (3) Event IDs & arguments are :
+*
+*                   Event ID                        Arg0                    Arg1
+*                   FTPc_TRACE_EVT_CTRL_REPLY       Reply code              Ctrl socket ID
+*                   FTPc_TRACE_EVT_DTP_OPEN         Data socket ID          Server data port
+*                   FTPc_TRACE_EVT_DTP_CLOSE        Data socket ID          FTPc error code
+*                   FTPc_TRACE_EVT_DTP_RX           Packet number           Nbr of octets rx'd
+*                   FTPc_TRACE_EVT_DTP_TX           Packet number           Nbr of octets tx'd
+*                   FTPc_TRACE_EVT_DTP_RX_ERR       Network error code      Data socket ID
+*                   FTPc_TRACE_EVT_DTP_TX_ERR       Network error code      Packet number
+*
+*               Event IDs values MUST NOT be changed since they are decoded by offline tools.
+*
+*           (4) FTPc_TRACE_MB() is a memory barrier that orders the accesses to the fields of a record
+*               & to its sequence number, so that a reader never accepts a record that is still being
+*               written. It defaults to __sync_synchronize() with GCC-compatible compilers & MUST be
+*               #define'd in 'ftp-c_cfg.h' otherwise (e.g. as the compiler's memory barrier intrinsic).
+*********************************************************************************************************
+*/
+
+#define  FTPc_TRACE_EVT_NONE                               0u   /* See Note #3.                                         */
+#define  FTPc_TRACE_EVT_CTRL_REPLY                         1u
+#define  FTPc_TRACE_EVT_DTP_OPEN                           2u
+#define  FTPc_TRACE_EVT_DTP_CLOSE                          3u
+#define  FTPc_TRACE_EVT_DTP_RX                             4u
+#define  FTPc_TRACE_EVT_DTP_TX                             5u
+#define  FTPc_TRACE_EVT_DTP_RX_ERR                         6u
+#define  FTPc_TRACE_EVT_DTP_TX_ERR                         7u
+
+#ifndef  FTPc_TRACE_MB                                          /* See Note #4.                                         */
+#if     (defined(__GNUC__) || defined(__clang__))
+#define  FTPc_TRACE_MB()                   __sync_synchronize()
+#endif
+#endif
+
+#if (FTPc_CFG_TRACE_BUF_EN == DEF_ENABLED)
+typedef  struct  ftpc_trace_rec {                               /* See Note #2.                                         */
+             CPU_TS32    TS;
+             CPU_INT16U  EvtID;
+    volatile CPU_INT16U  Seq;                                   /* Written last (see Note #4).                          */
+             CPU_INT32U  Arg0;
+             CPU_INT32U  Arg1;
+} FTPc_TRACE_REC;
+
+typedef  struct  ftpc_trace_buf {
+    CPU_INT32U      Ix;                                         /* Nbr of records written.                              */
+    FTPc_TRACE_REC  Tbl[FTPc_CFG_TRACE_BUF_NBR_EVT];
+} FTPc_TRACE_BUF;
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      FTPc HISTOGRAMS DATA TYPE
+*
+* Note(s) : (1) When FTPc_CFG_HIST_EN is DEF_ENABLED, FTPc aggregates the following samples of all
+*               connections in log-linear histograms :
+*
+*               (a) CmdLat          Round-trip latency of each command, from the transmission of the
+*                                   command to the reception of its first reply, in microseconds.
+*                                   Histograms are indexed by FTP_CMD_* codes.
+*               (b) ConnLat         Control connection establishment time, including host name
+*                                   resolution, in microseconds.
+*               (c) XferRate        Data transfer throughput, from the data connection establishment
+*                                   to the transfer completion reply, in octets per second.
+*
+*           (2) Each power of 2 is split in 2 linear buckets. Bucket 'ix' counts the samples from
+*               FTPc_HistBktValGet(ix) up to FTPc_HistBktValGet(ix + 1) - 1, so that FTPc_HIST_NBR_BKT
+*               buckets cover the whole range of 32-bit samples with a relative error of at most 50%.
+*
+*           (3) The histograms require (FTP_CMD_MAX + 2) * FTPc_HIST_NBR_BKT * 4 octets of RAM.
+*********************************************************************************************************
+*/
+
+#define  FTPc_HIST_NBR_BKT                                64u   /* See Note #2.                                         */
+
+#if (FTPc_CFG_HIST_EN == DEF_ENABLED)
+typedef  struct  ftpc_hist {
+    CPU_INT32U  CmdLat[FTP_CMD_MAX][FTPc_HIST_NBR_BKT];         /* See Note #1a.                                        */
+    CPU_INT32U  ConnLat[FTPc_HIST_NBR_BKT];                     /* See Note #1b.                                        */
+    CPU_INT32U  XferRate[FTPc_HIST_NBR_BKT];                    /* See Note #1c.                                        */
+} FTPc_HIST;
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      FTPc RATE LIMIT DATA TYPE
+*
+* Note(s) : (1) When FTPc_CFG_RATE_LIMIT_EN is DEF_ENABLED, the data transfers of each connection are
+*               limited by two token buckets : the bucket of the connection & a global bucket shared by
+*               all connections (see FTPc_RateLimitSet()). Control connection traffic is never limited.
+*
+*           (2) Tokens MAY be negative after a transfer larger than the available tokens; the next
+*               transfer then waits until the debt is repaid.
+*********************************************************************************************************
+*/
+
+#if (FTPc_CFG_RATE_LIMIT_EN == DEF_ENABLED)
+typedef  struct  ftpc_rate_limit {
+    CPU_INT32U  Rate;                                           /* Sustained rate, in octets/s; 0 if disabled.          */
+    CPU_INT32U  Burst;                                          /* Max nbr of tokens.                                   */
+    CPU_INT32S  Tokens;                                         /* Nbr of octets avail (see Note #2).                   */
+    CPU_INT32U  TS_ms;                                          /* Time of last refill.                                 */
+} FTPc_RATE_LIMIT;
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        FTPc TRANSFER PRIORITY
+*
+* Note(s) : (1) When FTPc_CFG_SCHED_EN is DEF_ENABLED, the data transfers of all connections are
+*               scheduled by priority class (see FTPc_PrioSet()). A transfer is paused between chunks of
+*               data while any transfer of a higher priority class is active (see FTPc_SchedYield()).
+*
+*           (2) Transfers of the same priority class share the bandwidth like their TCP connections
+*               do; FTPc_RateLimitSet() MAY be used to further weight them.
+*
+*           (3) A paused transfer is never starved : it sends one chunk of data after a pause of
+*               FTPc_CFG_SCHED_PAUSE_MAX_MS milliseconds per priority class between its own class &
+*               the highest active class.
+*********************************************************************************************************
+*/
+
+#define  FTPc_PRIO_HIGH                                    0u
+#define  FTPc_PRIO_NORMAL                                  1u
+#define  FTPc_PRIO_LOW                                     2u
+#define  FTPc_PRIO_NBR                                     3u
+
+
 /*
 *********************************************************************************************************
 *                                    FTP CONNECTION CFG DATA TYPE
@@ -232,13 +766,58 @@ typedef  struct  ftpc_conn {
            NET_SOCK_ID         SockID;
            NET_SOCK_ADDR       SockAddr;
            NET_IP_ADDR_FAMILY  SockAddrFamily;
+    const  FTPc_CFG           *CfgPtr;                         /* Cfg passed to FTPc_Open().                           */
 #ifdef  NET_SECURE_MODULE_EN
     const  FTPc_SECURE_CFG    *SecureCfgPtr;
+           void               *SecureSessionPtr;               /* TLS session resumed by data conns.                   */
+           CPU_CHAR            Prot;                           /* Protection level of xfers (see FTPc_ProtSet()).      */
+           CPU_CHAR            ProtCur;                        /* Protection level set on server.                      */
+#endif
+           CPU_INT08U          Buf[FTPc_CTRL_NET_BUF_SIZE];    /* Ctrl reply data not yet consumed by the client.      */
+           CPU_INT16U          BufLen;                         /* Len of pending ctrl reply data in Buf.               */
+           CPU_BOOLEAN         CtrlFail;                       /* Ctrl conn out of sync; MUST be closed.               */
+           CPU_BOOLEAN         BatchEn;                        /* Batch transfer mode en'd.                            */
+           CPU_BOOLEAN         PasvRdy;                        /* Passive addr & port rx'd but not yet used.           */
+           NET_PORT_NBR        PasvPort;                       /* Passive port of next data conn.                      */
+           CPU_CHAR            Type;                           /* Data type of xfers (see FTPc_TypeSet()).             */
+           CPU_CHAR            TypeCur;                        /* Data type set on server (see FTPc_TypeReq()).        */
+           CPU_BOOLEAN         AsciiCR;                        /* Last ASCII data octet processed is a CR.             */
+#ifdef  NET_IPv4_MODULE_EN
+           NET_IPv4_ADDR       PasvAddrIPv4;                   /* Passive IPv4 addr of next data conn.                 */
+#endif
+#if (FTPc_CFG_STAT_EN == DEF_ENABLED)
+           FTPc_STAT           Stat;                           /* Stats of last op.                                    */
+#endif
+#if (FTPc_CFG_HIST_EN == DEF_ENABLED)
+           CPU_INT08U          HistCmdCode;                    /* Code of cmd waiting for its reply.                   */
+           CPU_TS32            HistTS;                         /* Start of cmd or conn being timed.                    */
+           CPU_TS32            HistXferTS;                     /* Start of data xfer.                                  */
+           CPU_INT32U          HistXferLen;                    /* Nbr of octets xfer'd.                                */
+#endif
+#if (FTPc_CFG_META_CACHE_EN == DEF_ENABLED)
+           FTPc_META_ENTRY     MetaCache[FTPc_CFG_META_CACHE_NBR_ENTRY];
+#endif
+#if (FTPc_CFG_RATE_LIMIT_EN == DEF_ENABLED)
+           FTPc_RATE_LIMIT     RateLimit;                      /* See 'FTPc RATE LIMIT  Note #1'.                      */
+#endif
+#if (FTPc_CFG_SCHED_EN == DEF_ENABLED)
+           CPU_INT08U          Prio;                           /* Prio class of xfers (see FTPc_PrioSet()).            */
+           CPU_BOOLEAN         SchedXferEn;                    /* Data xfer active.                                    */
 #endif
-           CPU_INT08U          Buf[FTPc_CTRL_NET_BUF_SIZE];
 } FTPc_CONN;
 
 
+/*
+*********************************************************************************************************
+*                                          GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+#if (FTPc_CFG_TRACE_BUF_EN == DEF_ENABLED)
+FTPc_EXT  FTPc_TRACE_BUF  FTPc_TraceBuf;                        /* See 'FTPc TRACE BUFFER  Note #1'.                    */
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                         FUNCTION PROTOTYPES
@@ -264,6 +843,13 @@ CPU_BOOLEAN  FTPc_RecvBuf (      FTPc_CONN        *p_conn,
                                  CPU_INT32U       *p_file_size,
                                  FTPc_ERR         *p_err);
 
+CPU_BOOLEAN  FTPc_RecvBufChain(FTPc_CONN     *p_conn,
+                               CPU_CHAR      *p_remote_file_name,
+                               FTPc_BUF_SEG  *p_seg_tbl,
+                               CPU_SIZE_T     seg_nbr,
+                               CPU_INT32U    *p_file_size,
+                               FTPc_ERR      *p_err);
+
 CPU_BOOLEAN  FTPc_SendBuf (      FTPc_CONN        *p_conn,
                                  CPU_CHAR         *p_remote_file_name,
                                  CPU_INT08U       *p_buf,
@@ -271,6 +857,13 @@ CPU_BOOLEAN  FTPc_SendBuf (      FTPc_CONN        *p_conn,
                                  CPU_BOOLEAN       append,
                                  FTPc_ERR         *p_err);
 
+CPU_BOOLEAN  FTPc_SendBufVect (      FTPc_CONN     *p_conn,
+                                     CPU_CHAR      *p_remote_file_name,
+                               const FTPc_BUF_SEG  *p_seg_tbl,
+                                     CPU_SIZE_T     seg_nbr,
+                                     CPU_BOOLEAN    append,
+                                     FTPc_ERR      *p_err);
+
 CPU_BOOLEAN  FTPc_RecvFile(      FTPc_CONN        *p_conn,
                                  CPU_CHAR         *p_remote_file_name,
                                  CPU_CHAR         *p_local_file_name,
@@ -282,6 +875,109 @@ CPU_BOOLEAN  FTPc_SendFile(      FTPc_CONN        *p_conn,
                                  CPU_BOOLEAN       append,
                                  FTPc_ERR         *p_net);
 
+CPU_BOOLEAN  FTPc_SendFileSrc (      FTPc_CONN          *p_conn,
+                                     CPU_CHAR           *p_remote_file_name,
+                               const FTPc_FILE_SRC_API  *p_src_api,
+                                     CPU_CHAR           *p_local_file_name,
+                                     CPU_BOOLEAN         append,
+                                     FTPc_ERR           *p_err);
+
+CPU_BOOLEAN  FTPc_SendFileBatch (      FTPc_CONN             *p_conn,
+                                 const FTPc_FILE_PAIR        *p_file_tbl,
+                                       CPU_SIZE_T             file_nbr,
+                                 const FTPc_FILE_SRC_API     *p_src_api,
+                                       FTPc_XFER_RESULT_FNCT  p_result_fnct,
+                                       void                  *p_result_arg,
+                                       FTPc_ERR              *p_err);
+
+CPU_BOOLEAN  FTPc_RecvBlkDev  (FTPc_CONN     *p_conn,
+                               CPU_CHAR      *p_remote_file_name,
+                               FTPc_BLK_DEV  *p_dev,
+                               CPU_INT32U    *p_file_size,
+                               FTPc_ERR      *p_err);
+
+void         FTPc_BatchModeSet(FTPc_CONN    *p_conn,
+                               CPU_BOOLEAN   en);
+
+CPU_BOOLEAN  FTPc_TypeSet     (FTPc_CONN    *p_conn,
+                               CPU_CHAR      type);
+
+#ifdef  NET_SECURE_MODULE_EN
+CPU_BOOLEAN  FTPc_ProtSet     (FTPc_CONN    *p_conn,
+                               CPU_CHAR      prot);
+#endif
+
+CPU_BOOLEAN  FTPc_Dele         (FTPc_CONN       *p_conn,
+                                CPU_CHAR        *p_path,
+                                FTPc_ERR        *p_err);
+
+CPU_BOOLEAN  FTPc_Rename       (FTPc_CONN       *p_conn,
+                                CPU_CHAR        *p_path,
+                                CPU_CHAR        *p_path_new,
+                                FTPc_ERR        *p_err);
+
+CPU_BOOLEAN  FTPc_MkDir        (FTPc_CONN       *p_conn,
+                                CPU_CHAR        *p_path,
+                                FTPc_ERR        *p_err);
+
+CPU_BOOLEAN  FTPc_RmDir        (FTPc_CONN       *p_conn,
+                                CPU_CHAR        *p_path,
+                                FTPc_ERR        *p_err);
+
+CPU_BOOLEAN  FTPc_ChDir        (FTPc_CONN       *p_conn,
+                                CPU_CHAR        *p_path,
+                                FTPc_ERR        *p_err);
+
+CPU_BOOLEAN  FTPc_WorkDirGet   (FTPc_CONN       *p_conn,
+                                CPU_CHAR        *p_path,
+                                CPU_SIZE_T       path_len,
+                                FTPc_ERR        *p_err);
+
+CPU_BOOLEAN  FTPc_RemoteOpBatch(FTPc_CONN       *p_conn,
+                                FTPc_REMOTE_OP  *p_op_tbl,
+                                CPU_SIZE_T       op_nbr,
+                                FTPc_ERR        *p_err);
+
+CPU_BOOLEAN  FTPc_FileInfoGet (FTPc_CONN       *p_conn,
+                               CPU_CHAR        *p_path,
+                               FTPc_FILE_INFO  *p_info,
+                               FTPc_ERR        *p_err);
+
+#if (FTPc_CFG_META_CACHE_EN == DEF_ENABLED)
+void         FTPc_FileInfoPut (FTPc_CONN       *p_conn,
+                               CPU_CHAR        *p_path,
+                               FTPc_FILE_INFO  *p_info);
+#endif
+
+#if (FTPc_CFG_RATE_LIMIT_EN == DEF_ENABLED)
+void         FTPc_RateLimitSet(FTPc_CONN    *p_conn,
+                               CPU_INT32U    rate,
+                               CPU_INT32U    burst);
+#endif
+
+#if (FTPc_CFG_SCHED_EN == DEF_ENABLED)
+CPU_BOOLEAN  FTPc_PrioSet     (FTPc_CONN    *p_conn,
+                               CPU_INT08U    prio);
+#endif
+
+#if (FTPc_CFG_STAT_EN == DEF_ENABLED)
+void         FTPc_StatGet     (FTPc_CONN    *p_conn,
+                               FTPc_STAT    *p_stat);
+#endif
+
+#if (FTPc_CFG_TRACE_BUF_EN == DEF_ENABLED)
+CPU_SIZE_T   FTPc_TraceRd     (CPU_INT32U      *p_ix,
+                               FTPc_TRACE_REC  *p_rec_tbl,
+                               CPU_SIZE_T       rec_nbr_max);
+#endif
+
+#if (FTPc_CFG_HIST_EN == DEF_ENABLED)
+void         FTPc_HistGet      (FTPc_HIST    *p_hist,
+                                CPU_BOOLEAN   reset);
+
+CPU_INT32U   FTPc_HistBktValGet(CPU_INT08U    bkt_ix);
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -303,7 +999,7 @@ CPU_BOOLEAN  FTPc_SendFile(      FTPc_CONN        *p_conn,
 #endif
 
 #ifndef  FTPc_TRACE_LEVEL
-#define  FTPc_TRACE_LEVEL                       TRACE_LEVEL_DBG
+#define  FTPc_TRACE_LEVEL                       TRACE_LEVEL_OFF
 #endif
 
 #ifndef  FTPc_TRACE
@@ -343,6 +1039,143 @@ CPU_BOOLEAN  FTPc_SendFile(      FTPc_CONN        *p_conn,
 #error  "FTPc_CFG_USE_FS  illegally #define'd in 'net_cfg.h' [MUST be DEF_DISABLED || DEF_ENABLED ]"
 #endif
 
+                                                    /* Size of the ctrl conn buf embedded in each FTPc_CONN.            */
+#ifndef  FTPc_CFG_CTRL_BUF_SIZE
+#error  "FTPc_CFG_CTRL_BUF_SIZE not #define'd in 'ftp-c_cfg.h' see template file in package named 'ftp-c_cfg.h'"
+#elif  ((FTPc_CFG_CTRL_BUF_SIZE <   128u) || \
+        (FTPc_CFG_CTRL_BUF_SIZE > 65535u))
+#error  "FTPc_CFG_CTRL_BUF_SIZE  illegally #define'd in 'ftp-c_cfg.h' [MUST be >= 128 && <= 65535]"
+#endif
+
+                                                    /* If DEF_ENABLED, per operation statistics are collected.          */
+#ifndef  FTPc_CFG_STAT_EN
+#error  "FTPc_CFG_STAT_EN not #define'd in 'ftp-c_cfg.h' see template file in package named 'ftp-c_cfg.h'"
+#elif  ((FTPc_CFG_STAT_EN != DEF_DISABLED) && \
+        (FTPc_CFG_STAT_EN != DEF_ENABLED ))
+#error  "FTPc_CFG_STAT_EN  illegally #define'd in 'ftp-c_cfg.h' [MUST be DEF_DISABLED || DEF_ENABLED ]"
+#endif
+
+                                                    /* If DEF_ENABLED, latency & throughput histograms are collected.   */
+#ifndef  FTPc_CFG_HIST_EN
+#error  "FTPc_CFG_HIST_EN not #define'd in 'ftp-c_cfg.h' see template file in package named 'ftp-c_cfg.h'"
+#elif  ((FTPc_CFG_HIST_EN != DEF_DISABLED) && \
+        (FTPc_CFG_HIST_EN != DEF_ENABLED ))
+#error  "FTPc_CFG_HIST_EN  illegally #define'd in 'ftp-c_cfg.h' [MUST be DEF_DISABLED || DEF_ENABLED ]"
+#endif
+
+                                                    /* If DEF_ENABLED, binary events are recorded in FTPc_TraceBuf.     */
+#ifndef  FTPc_CFG_TRACE_BUF_EN
+#error  "FTPc_CFG_TRACE_BUF_EN not #define'd in 'ftp-c_cfg.h' see template file in package named 'ftp-c_cfg.h'"
+#elif  ((FTPc_CFG_TRACE_BUF_EN != DEF_DISABLED) && \
+        (FTPc_CFG_TRACE_BUF_EN != DEF_ENABLED ))
+#error  "FTPc_CFG_TRACE_BUF_EN  illegally #define'd in 'ftp-c_cfg.h' [MUST be DEF_DISABLED || DEF_ENABLED ]"
+
+#elif   (FTPc_CFG_TRACE_BUF_EN == DEF_ENABLED)
+#ifndef  FTPc_CFG_TRACE_BUF_NBR_EVT
+#error  "FTPc_CFG_TRACE_BUF_NBR_EVT not #define'd in 'ftp-c_cfg.h' see template file in package named 'ftp-c_cfg.h'"
+#elif  ((FTPc_CFG_TRACE_BUF_NBR_EVT < 2u) || \
+        (FTPc_CFG_TRACE_BUF_NBR_EVT > 32768u) || \
+       ((FTPc_CFG_TRACE_BUF_NBR_EVT & (FTPc_CFG_TRACE_BUF_NBR_EVT - 1u)) != 0u))
+#error  "FTPc_CFG_TRACE_BUF_NBR_EVT  illegally #define'd in 'ftp-c_cfg.h' [MUST be a power of 2 >= 2 && <= 32768]"
+#endif
+
+#ifndef  FTPc_TRACE_MB
+#error  "FTPc_TRACE_MB  not #define'd in 'ftp-c_cfg.h' [see 'ftp-c.h  FTPc TRACE BUFFER  Note #4']"
+#endif
+#endif
+
+                                                    /* Default timestamps require the 32-bit CPU timestamp.             */
+#if     (defined(FTPc_TS_DFLT_EN)               && \
+        ((FTPc_CFG_STAT_EN      == DEF_ENABLED) || \
+         (FTPc_CFG_HIST_EN      == DEF_ENABLED) || \
+         (FTPc_CFG_TRACE_BUF_EN == DEF_ENABLED)))
+#if     (!defined(CPU_CFG_TS_32_EN) || \
+         (CPU_CFG_TS_32_EN != DEF_ENABLED))
+#error  "CPU_CFG_TS_32_EN  illegally #define'd in 'cpu_cfg.h' [MUST be DEF_ENABLED || FTPc_TS_GET() & FTPc_TS_TO_uS() #define'd in 'ftp-c_cfg.h' (see 'ftp-c.h  FTPc TIMESTAMP  Note #3')]"
+#endif
+#endif
+
+                                                    /* If DEF_ENABLED, remote file metadata is cached per conn.         */
+#ifndef  FTPc_CFG_META_CACHE_EN
+#error  "FTPc_CFG_META_CACHE_EN not #define'd in 'ftp-c_cfg.h' see template file in package named 'ftp-c_cfg.h'"
+#elif  ((FTPc_CFG_META_CACHE_EN != DEF_DISABLED) && \
+        (FTPc_CFG_META_CACHE_EN != DEF_ENABLED ))
+#error  "FTPc_CFG_META_CACHE_EN  illegally #define'd in 'ftp-c_cfg.h' [MUST be DEF_DISABLED || DEF_ENABLED ]"
+
+#elif   (FTPc_CFG_META_CACHE_EN == DEF_ENABLED)
+#ifndef  FTPc_CFG_META_CACHE_NBR_ENTRY
+#error  "FTPc_CFG_META_CACHE_NBR_ENTRY not #define'd in 'ftp-c_cfg.h' see template file in package named 'ftp-c_cfg.h'"
+#elif  ((FTPc_CFG_META_CACHE_NBR_ENTRY < 1u) || \
+        (FTPc_CFG_META_CACHE_NBR_ENTRY > 65535u))
+#error  "FTPc_CFG_META_CACHE_NBR_ENTRY  illegally #define'd in 'ftp-c_cfg.h' [MUST be >= 1 && <= 65535]"
+#endif
+
+#ifndef  FTPc_CFG_META_CACHE_PATH_LEN_MAX
+#error  "FTPc_CFG_META_CACHE_PATH_LEN_MAX not #define'd in 'ftp-c_cfg.h' see template file in package named 'ftp-c_cfg.h'"
+#elif  ((FTPc_CFG_META_CACHE_PATH_LEN_MAX < 2u) || \
+        (FTPc_CFG_META_CACHE_PATH_LEN_MAX > 65535u))
+#error  "FTPc_CFG_META_CACHE_PATH_LEN_MAX  illegally #define'd in 'ftp-c_cfg.h' [MUST be >= 2 && <= 65535]"
+#endif
+
+#ifndef  FTPc_CFG_META_CACHE_TTL_MS
+#error  "FTPc_CFG_META_CACHE_TTL_MS not #define'd in 'ftp-c_cfg.h' see template file in package named 'ftp-c_cfg.h'"
+#elif   (FTPc_CFG_META_CACHE_TTL_MS < 1u)
+#error  "FTPc_CFG_META_CACHE_TTL_MS  illegally #define'd in 'ftp-c_cfg.h' [MUST be >= 1]"
+#endif
+#endif
+
+                                                    /* If DEF_ENABLED, server addr are cached across FTPc_Open().       */
+#ifndef  FTPc_CFG_HOST_CACHE_EN
+#error  "FTPc_CFG_HOST_CACHE_EN not #define'd in 'ftp-c_cfg.h' see template file in package named 'ftp-c_cfg.h'"
+#elif  ((FTPc_CFG_HOST_CACHE_EN != DEF_DISABLED) && \
+        (FTPc_CFG_HOST_CACHE_EN != DEF_ENABLED ))
+#error  "FTPc_CFG_HOST_CACHE_EN  illegally #define'd in 'ftp-c_cfg.h' [MUST be DEF_DISABLED || DEF_ENABLED ]"
+
+#elif   (FTPc_CFG_HOST_CACHE_EN == DEF_ENABLED)
+#ifndef  FTPc_CFG_HOST_CACHE_NBR_ENTRY
+#error  "FTPc_CFG_HOST_CACHE_NBR_ENTRY not #define'd in 'ftp-c_cfg.h' see template file in package named 'ftp-c_cfg.h'"
+#elif  ((FTPc_CFG_HOST_CACHE_NBR_ENTRY < 1u) || \
+        (FTPc_CFG_HOST_CACHE_NBR_ENTRY > 65535u))
+#error  "FTPc_CFG_HOST_CACHE_NBR_ENTRY  illegally #define'd in 'ftp-c_cfg.h' [MUST be >= 1 && <= 65535]"
+#endif
+
+#ifndef  FTPc_CFG_HOST_CACHE_NAME_LEN_MAX
+#error  "FTPc_CFG_HOST_CACHE_NAME_LEN_MAX not #define'd in 'ftp-c_cfg.h' see template file in package named 'ftp-c_cfg.h'"
+#elif  ((FTPc_CFG_HOST_CACHE_NAME_LEN_MAX < 2u) || \
+        (FTPc_CFG_HOST_CACHE_NAME_LEN_MAX > 65535u))
+#error  "FTPc_CFG_HOST_CACHE_NAME_LEN_MAX  illegally #define'd in 'ftp-c_cfg.h' [MUST be >= 2 && <= 65535]"
+#endif
+
+#ifndef  FTPc_CFG_HOST_CACHE_TTL_MS
+#error  "FTPc_CFG_HOST_CACHE_TTL_MS not #define'd in 'ftp-c_cfg.h' see template file in package named 'ftp-c_cfg.h'"
+#elif   (FTPc_CFG_HOST_CACHE_TTL_MS < 1u)
+#error  "FTPc_CFG_HOST_CACHE_TTL_MS  illegally #define'd in 'ftp-c_cfg.h' [MUST be >= 1]"
+#endif
+#endif
+
+                                                    /* If DEF_ENABLED, data xfers MAY be rate limited.                  */
+#ifndef  FTPc_CFG_RATE_LIMIT_EN
+#error  "FTPc_CFG_RATE_LIMIT_EN not #define'd in 'ftp-c_cfg.h' see template file in package named 'ftp-c_cfg.h'"
+#elif  ((FTPc_CFG_RATE_LIMIT_EN != DEF_DISABLED) && \
+        (FTPc_CFG_RATE_LIMIT_EN != DEF_ENABLED ))
+#error  "FTPc_CFG_RATE_LIMIT_EN  illegally #define'd in 'ftp-c_cfg.h' [MUST be DEF_DISABLED || DEF_ENABLED ]"
+#endif
+
+                                                    /* If DEF_ENABLED, data xfers are scheduled by priority class.      */
+#ifndef  FTPc_CFG_SCHED_EN
+#error  "FTPc_CFG_SCHED_EN not #define'd in 'ftp-c_cfg.h' see template file in package named 'ftp-c_cfg.h'"
+#elif  ((FTPc_CFG_SCHED_EN != DEF_DISABLED) && \
+        (FTPc_CFG_SCHED_EN != DEF_ENABLED ))
+#error  "FTPc_CFG_SCHED_EN  illegally #define'd in 'ftp-c_cfg.h' [MUST be DEF_DISABLED || DEF_ENABLED ]"
+
+#elif   (FTPc_CFG_SCHED_EN == DEF_ENABLED)
+#ifndef  FTPc_CFG_SCHED_PAUSE_MAX_MS
+#error  "FTPc_CFG_SCHED_PAUSE_MAX_MS not #define'd in 'ftp-c_cfg.h' see template file in package named 'ftp-c_cfg.h'"
+#elif   (FTPc_CFG_SCHED_PAUSE_MAX_MS < 1u)
+#error  "FTPc_CFG_SCHED_PAUSE_MAX_MS  illegally #define'd in 'ftp-c_cfg.h' [MUST be >= 1]"
+#endif
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -53,9 +53,36 @@
 */
 
 
+/*
+*********************************************************************************************************
+*                                   FTPc SOCKET OPTIONS DATA TYPE
+*
+* Note(s) : (1) Queue sizes are in octets. A null queue size keeps the network stack's default size.
+*
+*           (2) NoDelay disables the Nagle algorithm & SHOULD be enabled on the control socket so that
+*               commands are transmitted without delay.
+*
+*           (3) NoDelay & KeepAlive are DEF_ENABLED, DEF_DISABLED or FTPc_SOCK_OPT_DFLT to keep the
+*               network stack's default.
+*********************************************************************************************************
+*/
+
+#define  FTPc_SOCK_OPT_DFLT                             0xFFu   /* See Note #3.                                         */
+
+typedef  struct  ftpc_sock_opt {
+    CPU_INT32U   RxQ_Size;                                      /* Rx queue size (see Note #1).                         */
+    CPU_INT32U   TxQ_Size;                                      /* Tx queue size (see Note #1).                         */
+    CPU_BOOLEAN  NoDelay;                                       /* DEF_ENABLED to dis Nagle (see Notes #2 & #3).        */
+    CPU_BOOLEAN  KeepAlive;                                     /* DEF_ENABLED to en TCP keep-alive (see Note #3).      */
+} FTPc_SOCK_OPT;
+
+
 /*
 *********************************************************************************************************
 *                                    FTPc CONFIGURATION DATA TYPE
+*
+* Note(s) : (1) Socket options pointers MAY be DEF_NULL to keep the network stack's default socket
+*               configuration.
 *********************************************************************************************************
 */
 
@@ -76,6 +103,9 @@ typedef  struct  ftpc_cfg {
 
     CPU_INT32U  DTP_TxMaxRetry;
     CPU_INT32U  DTP_TxMaxDly_ms;
+
+    const  FTPc_SOCK_OPT  *CtrlSockOptPtr;                      /* See Note #1.                                         */
+    const  FTPc_SOCK_OPT  *DTP_SockOptPtr;
 } FTPc_CFG;
 
 